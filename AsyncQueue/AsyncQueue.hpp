@@ -0,0 +1,201 @@
+#ifndef ASYNCQUEUE_HPP
+#define ASYNCQUEUE_HPP
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../RingDeque/RingDeque.hpp"
+
+namespace mystl {
+// 单线程的就绪队列，可以直接作为 AsyncQueue 的调度钩子。
+// 被唤醒的协程先排队，由 run() 在调用者的栈上依次恢复，避免生产者在 push 内部递归地恢复消费者
+class CoroutineRunQueue {
+	RingDeque<std::coroutine_handle<>> _ready;
+
+public:
+	void post(std::coroutine_handle<> handle) { _ready.push_back(handle); }
+	void operator()(std::coroutine_handle<> handle) { post(handle); }
+
+	// 恢复所有就绪协程，包括运行期间新加入的，返回恢复次数
+	uint64_t run();
+
+	[[nodiscard]] bool empty() const { return _ready.empty(); }
+};
+
+inline uint64_t CoroutineRunQueue::run() {
+	uint64_t resumed = 0;
+	while (!_ready.empty()) {
+		std::coroutine_handle<> handle = _ready.front();
+		_ready.pop_front();
+		handle.resume();
+		++resumed;
+	}
+	return resumed;
+}
+
+// 立即开始执行、结束时自行销毁的协程返回类型，用来启动无需等待结果的生产者和消费者
+struct DetachedTask {
+	struct promise_type {
+		DetachedTask get_return_object() noexcept { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() noexcept { std::terminate(); }
+	};
+};
+
+// 可以 co_await 的 FIFO 队列。队列为空时 co_await pop() 挂起当前协程，
+// push_back 把元素直接交给最早挂起的等待者，不经过链表，再通过调度钩子恢复它。
+// 没有设置钩子时在 push_back 内部直接恢复。ThreadSafe 为 true 时内部加锁，
+// 可以从任意线程 push，钩子负责把协程送回它应当运行的线程。
+// 队列销毁时不能还有挂起的等待者
+template <typename ElementType, bool ThreadSafe = false>
+class AsyncQueue {
+public:
+	using scheduler_type = std::function<void(std::coroutine_handle<>)>;
+
+private:
+	struct NullLock {
+		void lock() noexcept {}
+		void unlock() noexcept {}
+	};
+
+	using Lock = std::conditional_t<ThreadSafe, std::mutex, NullLock>;
+
+	class PopAwaiter {
+		AsyncQueue* _queue;
+		std::optional<ElementType> _slot;
+		std::coroutine_handle<> _handle;
+		PopAwaiter* _next = nullptr; // 等待者链表，节点就是挂起协程帧里的 awaiter 本身
+
+		friend class AsyncQueue;
+
+	public:
+		explicit PopAwaiter(AsyncQueue* queue) : _queue{queue} {}
+
+		bool await_ready() { return _queue->take(_slot); }
+		bool await_suspend(std::coroutine_handle<> handle) {
+			_handle = handle;
+			return _queue->enqueue_waiter(this);
+		}
+		ElementType await_resume() { return std::move(*_slot); }
+	};
+
+	DoublyLinkedList<ElementType> _items;
+	PopAwaiter* _waiters_head = nullptr;
+	PopAwaiter* _waiters_tail = nullptr;
+	uint64_t _waiting = 0;
+	scheduler_type _scheduler;
+	mutable Lock _lock;
+
+	bool take(std::optional<ElementType>& slot);
+	bool enqueue_waiter(PopAwaiter* awaiter);
+	void resume(std::coroutine_handle<> handle) {
+		if (_scheduler) {
+			_scheduler(handle);
+		} else {
+			handle.resume();
+		}
+	}
+
+public:
+	AsyncQueue() = default;
+	explicit AsyncQueue(scheduler_type scheduler) : _scheduler{std::move(scheduler)} {}
+
+	AsyncQueue(const AsyncQueue& ano_queue) = delete;
+	AsyncQueue& operator=(const AsyncQueue& ano_queue) = delete;
+
+	~AsyncQueue() = default;
+
+public:
+	void push_back(const ElementType& val);
+
+	// co_await queue.pop() 得到队首元素，队列为空时挂起直到有元素
+	[[nodiscard]] PopAwaiter pop() { return PopAwaiter(this); }
+	std::optional<ElementType> try_pop();
+
+	[[nodiscard]] uint64_t size() const;
+	[[nodiscard]] bool empty() const { return size() == 0; }
+	// 当前挂起等待的协程数
+	[[nodiscard]] uint64_t waiting() const;
+};
+
+template <typename ElementType, bool ThreadSafe>
+bool AsyncQueue<ElementType, ThreadSafe>::take(std::optional<ElementType>& slot) {
+	std::lock_guard lock(_lock);
+	if (_items.empty()) {
+		return false;
+	}
+	auto handle = _items.extract(_items.begin());
+	slot.emplace(std::move(handle.value()));
+	return true;
+}
+
+template <typename ElementType, bool ThreadSafe>
+bool AsyncQueue<ElementType, ThreadSafe>::enqueue_waiter(PopAwaiter* awaiter) {
+	std::lock_guard lock(_lock);
+	// await_ready 之后可能已有其他线程 push，此时不挂起
+	if (!_items.empty()) {
+		auto handle = _items.extract(_items.begin());
+		awaiter->_slot.emplace(std::move(handle.value()));
+		return false;
+	}
+	if (_waiters_tail) {
+		_waiters_tail->_next = awaiter;
+	} else {
+		_waiters_head = awaiter;
+	}
+	_waiters_tail = awaiter;
+	++_waiting;
+	return true;
+}
+
+template <typename ElementType, bool ThreadSafe>
+void AsyncQueue<ElementType, ThreadSafe>::push_back(const ElementType& val) {
+	std::unique_lock lock(_lock);
+	PopAwaiter* awaiter = _waiters_head;
+	if (!awaiter) {
+		_items.push_back(val);
+		return;
+	}
+
+	_waiters_head = awaiter->_next;
+	if (!_waiters_head) {
+		_waiters_tail = nullptr;
+	}
+	--_waiting;
+	awaiter->_slot.emplace(val);
+	const std::coroutine_handle<> handle = awaiter->_handle;
+	lock.unlock(); // 恢复的协程可能再次访问本队列
+	resume(handle);
+}
+
+template <typename ElementType, bool ThreadSafe>
+std::optional<ElementType> AsyncQueue<ElementType, ThreadSafe>::try_pop() {
+	std::optional<ElementType> slot;
+	take(slot);
+	return slot;
+}
+
+template <typename ElementType, bool ThreadSafe>
+uint64_t AsyncQueue<ElementType, ThreadSafe>::size() const {
+	std::lock_guard lock(_lock);
+	return _items.size();
+}
+
+template <typename ElementType, bool ThreadSafe>
+uint64_t AsyncQueue<ElementType, ThreadSafe>::waiting() const {
+	std::lock_guard lock(_lock);
+	return _waiting;
+}
+}
+
+
+#endif //ASYNCQUEUE_HPP
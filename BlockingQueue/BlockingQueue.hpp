@@ -0,0 +1,290 @@
+#ifndef BLOCKINGQUEUE_HPP
+#define BLOCKINGQUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+namespace mystl {
+// 有界阻塞队列。元素存放在受互斥锁保护的 DoublyLinkedList 中，锁只覆盖链表操作本身；
+// 等待不用条件变量，而是在两个序号（push 序号和 pop 序号）上做 futex 等待：
+// 先自旋 spin_count 次观察队列状态，仍不满足才挂起，而且只有确实有线程挂起时才发起唤醒系统调用。
+// 每次 push 只唤醒一个消费者，每次 pop 只唤醒相应数量的生产者，不会惊群。
+// C++20 的 atomic::wait 不支持超时，带超时的接口需要直接使用 futex，因此统一使用 futex
+template <typename ElementType>
+class BlockingQueue {
+private:
+	using Clock = std::chrono::steady_clock; // 与 FUTEX_WAIT_BITSET 默认的 CLOCK_MONOTONIC 一致
+
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free);
+
+	DoublyLinkedList<ElementType> _items;
+	uint64_t _capacity;
+	uint32_t _spin_count;
+	std::mutex _mutex;
+	std::atomic<uint64_t> _size{0}; // 供自旋和 size() 无锁读取
+
+	// 生产者和消费者各自修改的字段放在不同的缓存行
+	alignas(64) std::atomic<uint32_t> _push_seq{0};
+	std::atomic<uint32_t> _consumers_parked{0};
+	alignas(64) std::atomic<uint32_t> _pop_seq{0};
+	std::atomic<uint32_t> _producers_parked{0};
+
+	static void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	// 返回 0 表示被唤醒，否则返回 errno（EAGAIN、ETIMEDOUT、EINTR）
+	static int futex_wait(std::atomic<uint32_t>& word, uint32_t expected, const std::optional<Clock::time_point>& deadline);
+	static uint32_t futex_wake(std::atomic<uint32_t>& word, uint32_t count);
+	static void unpark(std::atomic<uint32_t>& parked);
+	// 递增序号并唤醒至多 count 个挂起在 seq 上的线程
+	static void notify(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& parked, uint32_t count);
+
+	bool push_locked(const ElementType& val);
+	uint64_t take_batch(std::span<ElementType> out, uint64_t max);
+	// 等待 ready() 成立、seq 偏离 observed 或超时，超时返回 false。
+	// seq 是对方每次操作都会递增的序号，observed 必须在检查队列状态之前读取，否则会错过唤醒
+	template <typename Ready>
+	bool wait(std::atomic<uint32_t>& seq, uint32_t observed, std::atomic<uint32_t>& parked, Ready ready,
+	          const std::optional<Clock::time_point>& deadline);
+
+	bool push_until(const ElementType& val, const std::optional<Clock::time_point>& deadline);
+	uint64_t pop_batch_until(std::span<ElementType> out, uint64_t max, const std::optional<Clock::time_point>& deadline);
+
+public:
+	explicit BlockingQueue(uint64_t capacity, uint32_t spin_count = 100);
+
+	BlockingQueue(const BlockingQueue& ano_queue) = delete;
+	BlockingQueue& operator=(const BlockingQueue& ano_queue) = delete;
+
+	~BlockingQueue() = default;
+
+public:
+	// 队列已满时立即返回 false
+	bool try_push(const ElementType& val);
+	// 队列已满时阻塞，直到有空位
+	void push(const ElementType& val) { push_until(val, std::nullopt); }
+	// 最多等待 timeout，超时返回 false
+	template <typename Rep, typename Period>
+	bool push_for(const ElementType& val, std::chrono::duration<Rep, Period> timeout) {
+		return push_until(val, Clock::now() + std::chrono::ceil<Clock::duration>(timeout));
+	}
+
+	std::optional<ElementType> try_pop();
+	ElementType pop();
+	// 最多等待 timeout 直到至少有一个元素，然后不再等待，取出至多 min(max, out.size()) 个，返回个数
+	template <typename Rep, typename Period>
+	uint64_t pop_batch(std::span<ElementType> out, uint64_t max, std::chrono::duration<Rep, Period> timeout) {
+		return pop_batch_until(out, max, Clock::now() + std::chrono::ceil<Clock::duration>(timeout));
+	}
+
+	[[nodiscard]] uint64_t size() const { return _size.load(std::memory_order_relaxed); }
+	[[nodiscard]] bool empty() const { return size() == 0; }
+	[[nodiscard]] bool full() const { return size() >= _capacity; }
+	[[nodiscard]] uint64_t capacity() const { return _capacity; }
+};
+
+template <typename ElementType>
+BlockingQueue<ElementType>::BlockingQueue(uint64_t capacity, uint32_t spin_count) :
+	_capacity{capacity}, _spin_count{spin_count} {
+	if (capacity == 0) {
+		throw std::invalid_argument("BlockingQueue capacity must be positive.");
+	}
+}
+
+template <typename ElementType>
+int BlockingQueue<ElementType>::futex_wait(std::atomic<uint32_t>& word, uint32_t expected,
+                                            const std::optional<Clock::time_point>& deadline) {
+	timespec absolute{};
+	if (deadline) {
+		const auto since_epoch = deadline->time_since_epoch();
+		const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+		absolute.tv_sec = static_cast<time_t>(seconds.count());
+		absolute.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds).count());
+	}
+	// 值已经变化时内核返回 EAGAIN
+	const long result = ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+	                              expected, deadline ? &absolute : nullptr, nullptr, FUTEX_BITSET_MATCH_ANY);
+	return result == 0 ? 0 : errno;
+}
+
+template <typename ElementType>
+uint32_t BlockingQueue<ElementType>::futex_wake(std::atomic<uint32_t>& word, uint32_t count) {
+	const long woken = ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+	                             count > INT_MAX ? INT_MAX : static_cast<int>(count), nullptr, nullptr, 0);
+	return woken > 0 ? static_cast<uint32_t>(woken) : 0;
+}
+
+template <typename ElementType>
+void BlockingQueue<ElementType>::unpark(std::atomic<uint32_t>& parked) {
+	uint32_t current = parked.load(std::memory_order_relaxed);
+	while (current != 0 && !parked.compare_exchange_weak(current, current - 1, std::memory_order_relaxed)) {
+	}
+}
+
+template <typename ElementType>
+void BlockingQueue<ElementType>::notify(std::atomic<uint32_t>& seq, std::atomic<uint32_t>& parked, uint32_t count) {
+	// 与等待方的 “登记 parked -> 重读序号” 构成 Dekker 式配对，两边都必须是 seq_cst
+	seq.fetch_add(1, std::memory_order_seq_cst);
+
+	// 唤醒方替被唤醒的线程注销登记：被唤醒的线程在真正运行之前，后续操作看到 parked 为 0，
+	// 不会每次都再发起一次系统调用（单核上这一点决定了吞吐）
+	uint32_t current = parked.load(std::memory_order_seq_cst);
+	uint32_t claimed;
+	do {
+		if (current == 0) {
+			return;
+		}
+		claimed = std::min(current, count);
+	} while (!parked.compare_exchange_weak(current, current - claimed, std::memory_order_seq_cst));
+
+	// 登记了但还没进入内核的线程会因序号变化收到 EAGAIN 并自行注销，这里把没送出去的认领还回去
+	const uint32_t woken = futex_wake(seq, claimed);
+	if (woken < claimed) {
+		parked.fetch_add(claimed - woken, std::memory_order_seq_cst);
+	}
+}
+
+template <typename ElementType>
+template <typename Ready>
+bool BlockingQueue<ElementType>::wait(std::atomic<uint32_t>& seq, uint32_t observed, std::atomic<uint32_t>& parked,
+                                      Ready ready, const std::optional<Clock::time_point>& deadline) {
+	for (uint32_t i = 0; i < _spin_count; ++i) {
+		if (ready() || seq.load(std::memory_order_relaxed) != observed) {
+			return true;
+		}
+		cpu_relax();
+	}
+	if (deadline && Clock::now() >= *deadline) {
+		return false;
+	}
+
+	parked.fetch_add(1, std::memory_order_seq_cst);
+	if (seq.load(std::memory_order_seq_cst) != observed) {
+		unpark(parked);
+		return true;
+	}
+	// 被唤醒时登记已由唤醒方注销；虚假唤醒只会让 parked 偏大，多一次无用的唤醒调用
+	const int error = futex_wait(seq, observed, deadline);
+	if (error != 0) {
+		unpark(parked);
+	}
+	return error != ETIMEDOUT;
+}
+
+template <typename ElementType>
+bool BlockingQueue<ElementType>::push_locked(const ElementType& val) {
+	std::lock_guard lock(_mutex);
+	if (_items.size() >= _capacity) {
+		return false;
+	}
+	_items.push_back(val);
+	_size.store(_items.size(), std::memory_order_relaxed);
+	return true;
+}
+
+template <typename ElementType>
+bool BlockingQueue<ElementType>::try_push(const ElementType& val) {
+	if (!push_locked(val)) {
+		return false;
+	}
+	notify(_push_seq, _consumers_parked, 1);
+	return true;
+}
+
+template <typename ElementType>
+bool BlockingQueue<ElementType>::push_until(const ElementType& val, const std::optional<Clock::time_point>& deadline) {
+	while (true) {
+		// 先读序号再检查队列，检查之后发生的 pop 一定会改变序号，不会错过唤醒
+		const uint32_t observed = _pop_seq.load(std::memory_order_seq_cst);
+		if (try_push(val)) {
+			return true;
+		}
+		if (!wait(_pop_seq, observed, _producers_parked, [this] { return !full(); }, deadline)) {
+			return try_push(val);
+		}
+	}
+}
+
+template <typename ElementType>
+std::optional<ElementType> BlockingQueue<ElementType>::try_pop() {
+	std::optional<ElementType> result;
+	{
+		std::lock_guard lock(_mutex);
+		if (_items.empty()) {
+			return result;
+		}
+		auto handle = _items.extract(_items.begin());
+		_size.store(_items.size(), std::memory_order_relaxed);
+		result.emplace(std::move(handle.value()));
+	}
+	notify(_pop_seq, _producers_parked, 1);
+	return result;
+}
+
+template <typename ElementType>
+ElementType BlockingQueue<ElementType>::pop() {
+	while (true) {
+		const uint32_t observed = _push_seq.load(std::memory_order_seq_cst);
+		if (auto result = try_pop()) {
+			return std::move(*result);
+		}
+		wait(_push_seq, observed, _consumers_parked, [this] { return !empty(); }, std::nullopt);
+	}
+}
+
+template <typename ElementType>
+uint64_t BlockingQueue<ElementType>::take_batch(std::span<ElementType> out, uint64_t max) {
+	uint64_t popped;
+	{
+		std::lock_guard lock(_mutex);
+		popped = _items.pop_front_batch(out, max);
+		_size.store(_items.size(), std::memory_order_relaxed);
+	}
+	if (popped > 0) {
+		notify(_pop_seq, _producers_parked, static_cast<uint32_t>(std::min<uint64_t>(popped, UINT32_MAX)));
+	}
+	return popped;
+}
+
+template <typename ElementType>
+uint64_t BlockingQueue<ElementType>::pop_batch_until(std::span<ElementType> out, uint64_t max,
+                                                     const std::optional<Clock::time_point>& deadline) {
+	max = std::min<uint64_t>(max, out.size());
+	if (max == 0) {
+		return 0;
+	}
+	while (true) {
+		const uint32_t observed = _push_seq.load(std::memory_order_seq_cst);
+		if (const uint64_t popped = take_batch(out, max)) {
+			return popped;
+		}
+		if (!wait(_push_seq, observed, _consumers_parked, [this] { return !empty(); }, deadline)) {
+			return take_batch(out, max); // 超时前最后检查一次
+		}
+	}
+}
+}
+
+
+#endif //BLOCKINGQUEUE_HPP
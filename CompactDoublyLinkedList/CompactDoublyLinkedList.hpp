@@ -0,0 +1,545 @@
+#ifndef COMPACTDOUBLYLINKEDLIST_HPP
+#define COMPACTDOUBLYLINKEDLIST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace mystl {
+// 压缩链接的双向链表：所有节点放在同一块连续的区域中，前后链接是 32 位槽位下标而不是指针，
+// 链接只占 8 字节，一条缓存行能容纳更多节点。槽位 0 是哨兵，空闲槽位通过 _next 串起来。
+// 接口与 DoublyLinkedList 保持一致；区域写满时按倍数扩容并搬移元素，
+// 迭代器以下标表示，扩容后仍然有效，但元素的地址会改变。最多容纳 2^32 - 2 个元素。
+// 迭代器保存的是所属链表对象的地址（扩容后才能找到新区域），因此与 DoublyLinkedList 不同，
+// 链表被移动构造或移动赋值后，原有的迭代器全部失效。
+template <typename ElementType, typename Allocator = std::allocator<ElementType>>
+struct CompactDoublyLinkedList {
+private:
+	using index_type = uint32_t;
+
+	static constexpr index_type sentinel = 0;
+	static constexpr uint64_t max_slots = UINT32_MAX;
+	static constexpr uint64_t initial_slots = 16;
+
+	// 空闲槽位中 _val 不存活
+	struct CompactNode {
+		index_type _prev = sentinel;
+		index_type _next = sentinel;
+		union {
+			ElementType _val;
+		};
+
+		CompactNode() {}
+		~CompactNode() {}
+	};
+
+public:
+	using Node = CompactNode;
+	using allocator_type = Allocator;
+
+private:
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+
+	class Iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = ElementType*;
+		using reference = ElementType&;
+
+		const CompactDoublyLinkedList* _list = nullptr;
+		index_type _current = sentinel;
+
+	public:
+		Iterator() = default;
+		Iterator(const CompactDoublyLinkedList* list, index_type current) : _list{list}, _current{current} {}
+
+	public:
+		ElementType& operator*() const { return _list->_nodes[_current]._val; }
+		ElementType* operator->() const { return &_list->_nodes[_current]._val; }
+
+		Iterator& operator++() {
+			_current = _list->_nodes[_current]._next;
+			return *this;
+		}
+
+		Iterator& operator--() {
+			_current = _list->_nodes[_current]._prev;
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator old = *this;
+			++*this;
+			return old;
+		}
+
+		Iterator operator--(int) {
+			Iterator old = *this;
+			--*this;
+			return old;
+		}
+
+		bool operator!=(const Iterator& ano_iter) const { return _current != ano_iter._current; }
+		bool operator==(const Iterator& ano_iter) const { return _current == ano_iter._current; }
+	};
+
+public:
+	using iterator = Iterator;
+
+private:
+	uint64_t _size = 0;
+	Node* _nodes = nullptr; // 区域本身，_nodes[0] 是哨兵
+	uint64_t _capacity = 0; // 槽位总数，含哨兵
+	index_type _free = sentinel;
+	[[no_unique_address]] NodeAllocator _alloc;
+
+	Node& node(index_type index) const { return _nodes[index]; }
+	void grow(uint64_t capacity);
+	void release() noexcept;
+	index_type acquire_slot(const ElementType& val);
+	void release_slot(index_type index) noexcept;
+	void link_before(index_type pos, index_type index) noexcept;
+	void unlink(index_type index) noexcept;
+	uint64_t release_chain(index_type first) noexcept;
+
+public:
+	CompactDoublyLinkedList() noexcept = default;
+	explicit CompactDoublyLinkedList(const Allocator& alloc) noexcept : _alloc{alloc} {}
+	explicit CompactDoublyLinkedList(uint64_t size);
+	CompactDoublyLinkedList(uint64_t size, ElementType val);
+	CompactDoublyLinkedList(const Iterator& begin, const Iterator& end);
+	CompactDoublyLinkedList(std::initializer_list<ElementType> list);
+
+	CompactDoublyLinkedList(const CompactDoublyLinkedList& ano_list);
+	CompactDoublyLinkedList& operator=(const CompactDoublyLinkedList& ano_list);
+
+	CompactDoublyLinkedList(CompactDoublyLinkedList&& ano_list) noexcept;
+	CompactDoublyLinkedList& operator=(CompactDoublyLinkedList&& ano_list) noexcept;
+
+	~CompactDoublyLinkedList() { release(); }
+
+public:
+	Iterator begin() const { return Iterator(this, _capacity ? node(sentinel)._next : sentinel); }
+	Iterator end() const { return Iterator(this, sentinel); }
+	ElementType front() const { return node(node(sentinel)._next)._val; }
+	ElementType back() const { return node(node(sentinel)._prev)._val; }
+	[[nodiscard]] uint64_t size() const { return _size; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+	[[nodiscard]] uint64_t capacity() const { return _capacity ? _capacity - 1 : 0; }
+
+	void push_front(const ElementType& val);
+	void push_back(const ElementType& val);
+	void insert(Iterator it, const ElementType& val);
+
+	void pop_back();
+	void pop_front();
+
+	Iterator erase(Iterator it);
+	Iterator erase(Iterator first, Iterator last);
+	uint64_t remove(const ElementType& val);
+	template <typename Predicate>
+	uint64_t remove_if(Predicate pred);
+	uint64_t unique();
+	template <typename BinaryPredicate>
+	uint64_t unique(BinaryPredicate pred);
+
+	void clear();
+	// 预留至少 capacity 个元素的槽位，之后的插入不再搬移元素
+	void reserve(uint64_t capacity);
+
+	[[nodiscard]] allocator_type get_allocator() const { return allocator_type(_alloc); }
+};
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>::CompactDoublyLinkedList(uint64_t size) {
+	reserve(size);
+	for (uint64_t i = 0; i < size; ++i) {
+		push_back(ElementType{});
+	}
+}
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>::CompactDoublyLinkedList(uint64_t size, ElementType val) {
+	reserve(size);
+	for (uint64_t i = 0; i < size; ++i) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>::CompactDoublyLinkedList(const Iterator& begin, const Iterator& end) {
+	for (auto it = begin; it != end; ++it) {
+		push_back(*it);
+	}
+}
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>::CompactDoublyLinkedList(std::initializer_list<ElementType> list) {
+	reserve(list.size());
+	for (const auto& val : list) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>::CompactDoublyLinkedList(const CompactDoublyLinkedList& ano_list) :
+	_alloc{NodeAllocTraits::select_on_container_copy_construction(ano_list._alloc)} {
+	// 按链表顺序复制，副本中的节点在区域里是连续的
+	reserve(ano_list._size);
+	for (const auto& val : ano_list) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>&
+CompactDoublyLinkedList<ElementType, Allocator>::operator=(const CompactDoublyLinkedList& ano_list) {
+	if (this != &ano_list) {
+		clear();
+		if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value) {
+			release();
+			_alloc = ano_list._alloc;
+		}
+		reserve(ano_list._size);
+		for (const auto& val : ano_list) {
+			push_back(val);
+		}
+	}
+	return *this;
+}
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>::CompactDoublyLinkedList(CompactDoublyLinkedList&& ano_list) noexcept :
+	_size{std::exchange(ano_list._size, 0)},
+	_nodes{std::exchange(ano_list._nodes, nullptr)},
+	_capacity{std::exchange(ano_list._capacity, 0)},
+	_free{std::exchange(ano_list._free, sentinel)},
+	_alloc{std::move(ano_list._alloc)} {}
+
+template <typename ElementType, typename Allocator>
+CompactDoublyLinkedList<ElementType, Allocator>&
+CompactDoublyLinkedList<ElementType, Allocator>::operator=(CompactDoublyLinkedList&& ano_list) noexcept {
+	if (this != &ano_list) {
+		// 链接是区域内的下标，整块区域换手即可，哨兵不需要重新链接
+		release();
+		if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value) {
+			_alloc = std::move(ano_list._alloc);
+		}
+		_size = std::exchange(ano_list._size, 0);
+		_nodes = std::exchange(ano_list._nodes, nullptr);
+		_capacity = std::exchange(ano_list._capacity, 0);
+		_free = std::exchange(ano_list._free, sentinel);
+	}
+	return *this;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::grow(uint64_t capacity) {
+	if (capacity > max_slots) {
+		throw std::length_error("CompactDoublyLinkedList exceeds 32-bit slot indices.");
+	}
+
+	Node* nodes = NodeAllocTraits::allocate(_alloc, capacity);
+	for (uint64_t i = 0; i < capacity; ++i) {
+		NodeAllocTraits::construct(_alloc, nodes + i);
+	}
+
+	// 链接按槽位原样复制；元素沿链表搬到同一个槽位
+	uint64_t moved = 0;
+	try {
+		for (uint64_t i = 0; i < _capacity; ++i) {
+			nodes[i]._prev = _nodes[i]._prev;
+			nodes[i]._next = _nodes[i]._next;
+		}
+		for (index_type i = _capacity ? _nodes[sentinel]._next : sentinel; i != sentinel; i = _nodes[i]._next) {
+			std::construct_at(&nodes[i]._val, std::move_if_noexcept(_nodes[i]._val));
+			++moved;
+		}
+	} catch (...) {
+		// 只有已有元素时才会走到这里
+		for (index_type i = _nodes[sentinel]._next; moved > 0; i = _nodes[i]._next, --moved) {
+			std::destroy_at(&nodes[i]._val);
+		}
+		NodeAllocTraits::deallocate(_alloc, nodes, capacity);
+		throw;
+	}
+
+	if (_capacity == 0) {
+		nodes[sentinel]._prev = sentinel;
+		nodes[sentinel]._next = sentinel;
+	}
+
+	// 新增的槽位按下标顺序挂到空闲链表前面，顺序追加时节点在区域里保持连续
+	const auto first_new = static_cast<index_type>(_capacity ? _capacity : 1);
+	for (uint64_t i = first_new; i + 1 < capacity; ++i) {
+		nodes[i]._next = static_cast<index_type>(i + 1);
+	}
+	nodes[capacity - 1]._next = _free;
+	_free = first_new;
+
+	if (_nodes) {
+		for (index_type i = _nodes[sentinel]._next; i != sentinel; i = _nodes[i]._next) {
+			std::destroy_at(&_nodes[i]._val);
+		}
+		NodeAllocTraits::deallocate(_alloc, _nodes, _capacity);
+	}
+	_nodes = nodes;
+	_capacity = capacity;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::release() noexcept {
+	clear();
+	if (_nodes) {
+		NodeAllocTraits::deallocate(_alloc, _nodes, _capacity);
+		_nodes = nullptr;
+	}
+	_capacity = 0;
+	_free = sentinel;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::reserve(uint64_t capacity) {
+	if (capacity + 1 > _capacity) {
+		grow(capacity + 1);
+	}
+}
+
+template <typename ElementType, typename Allocator>
+typename CompactDoublyLinkedList<ElementType, Allocator>::index_type
+CompactDoublyLinkedList<ElementType, Allocator>::acquire_slot(const ElementType& val) {
+	if (_free == sentinel) {
+		if (_capacity == max_slots) {
+			throw std::length_error("CompactDoublyLinkedList exceeds 32-bit slot indices.");
+		}
+		// val 可能引用区域中的元素，扩容前先复制一份
+		ElementType copy(val);
+		// 最后一次扩容截断到 max_slots，否则容量超过 2^31 后翻倍就会越界
+		grow(_capacity ? std::min<uint64_t>(_capacity * 2, max_slots) : initial_slots);
+		const index_type index = _free;
+		std::construct_at(&node(index)._val, std::move(copy));
+		_free = node(index)._next;
+		return index;
+	}
+	const index_type index = _free;
+	std::construct_at(&node(index)._val, val);
+	_free = node(index)._next;
+	return index;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::release_slot(index_type index) noexcept {
+	std::destroy_at(&node(index)._val);
+	node(index)._next = _free;
+	_free = index;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::link_before(index_type pos, index_type index) noexcept {
+	node(index)._prev = node(pos)._prev;
+	node(index)._next = pos;
+	node(node(pos)._prev)._next = index;
+	node(pos)._prev = index;
+	_size++;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::unlink(index_type index) noexcept {
+	node(node(index)._prev)._next = node(index)._next;
+	node(node(index)._next)._prev = node(index)._prev;
+	_size--;
+}
+
+template <typename ElementType, typename Allocator>
+uint64_t CompactDoublyLinkedList<ElementType, Allocator>::release_chain(index_type first) noexcept {
+	// 沿 _next 释放一条以哨兵下标结尾的已摘下节点链
+	uint64_t count = 0;
+	while (first != sentinel) {
+		const index_type next_index = node(first)._next;
+		release_slot(first);
+		first = next_index;
+		++count;
+	}
+	return count;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::push_front(const ElementType& val) {
+	const index_type index = acquire_slot(val);
+	link_before(node(sentinel)._next, index);
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::push_back(const ElementType& val) {
+	const index_type index = acquire_slot(val);
+	link_before(sentinel, index);
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::insert(Iterator it, const ElementType& val) {
+	const index_type index = acquire_slot(val);
+	link_before(it._current, index);
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	const index_type index = node(sentinel)._prev;
+	unlink(index);
+	release_slot(index);
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	const index_type index = node(sentinel)._next;
+	unlink(index);
+	release_slot(index);
+}
+
+template <typename ElementType, typename Allocator>
+typename CompactDoublyLinkedList<ElementType, Allocator>::Iterator
+CompactDoublyLinkedList<ElementType, Allocator>::erase(Iterator it) {
+	const index_type next_index = node(it._current)._next;
+	unlink(it._current);
+	release_slot(it._current);
+	return Iterator(this, next_index);
+}
+
+template <typename ElementType, typename Allocator>
+typename CompactDoublyLinkedList<ElementType, Allocator>::Iterator
+CompactDoublyLinkedList<ElementType, Allocator>::erase(Iterator first, Iterator last) {
+	if (first == last) {
+		return last;
+	}
+
+	// 整段一次性摘下，再沿原来的 _next 逐个归还槽位
+	const index_type before = node(first._current)._prev;
+	const index_type tail = node(last._current)._prev;
+	node(before)._next = last._current;
+	node(last._current)._prev = before;
+	node(tail)._next = sentinel;
+
+	_size -= release_chain(first._current);
+	return last;
+}
+
+template <typename ElementType, typename Allocator>
+uint64_t CompactDoublyLinkedList<ElementType, Allocator>::remove(const ElementType& val) {
+	// val 可能引用链表中的元素，槽位延迟到遍历结束后才归还，因此可以安全比较
+	return remove_if([&val](const ElementType& elem) { return elem == val; });
+}
+
+template <typename ElementType, typename Allocator>
+template <typename Predicate>
+uint64_t CompactDoublyLinkedList<ElementType, Allocator>::remove_if(Predicate pred) {
+	if (empty()) {
+		return 0;
+	}
+
+	// 被删除的节点借用 _next 串成一条待释放链，遍历结束后统一归还
+	index_type removed_head = sentinel;
+	index_type removed_tail = sentinel;
+	uint64_t removed = 0;
+
+	auto flush = [&] {
+		if (removed_tail != sentinel) {
+			node(removed_tail)._next = sentinel;
+		}
+		release_chain(removed_head);
+	};
+
+	try {
+		index_type current = node(sentinel)._next;
+		while (current != sentinel) {
+			const index_type next_index = node(current)._next;
+			if (pred(node(current)._val)) {
+				unlink(current);
+				(removed_tail != sentinel ? node(removed_tail)._next : removed_head) = current;
+				removed_tail = current;
+				++removed;
+			}
+			current = next_index;
+		}
+	} catch (...) {
+		flush();
+		throw;
+	}
+
+	flush();
+	return removed;
+}
+
+template <typename ElementType, typename Allocator>
+uint64_t CompactDoublyLinkedList<ElementType, Allocator>::unique() {
+	return unique([](const ElementType& lhs, const ElementType& rhs) { return lhs == rhs; });
+}
+
+template <typename ElementType, typename Allocator>
+template <typename BinaryPredicate>
+uint64_t CompactDoublyLinkedList<ElementType, Allocator>::unique(BinaryPredicate pred) {
+	if (_size < 2) {
+		return 0;
+	}
+
+	index_type removed_head = sentinel;
+	index_type removed_tail = sentinel;
+	uint64_t removed = 0;
+
+	auto flush = [&] {
+		if (removed_tail != sentinel) {
+			node(removed_tail)._next = sentinel;
+		}
+		release_chain(removed_head);
+	};
+
+	try {
+		index_type kept = node(sentinel)._next;
+		index_type current = node(kept)._next;
+		while (current != sentinel) {
+			const index_type next_index = node(current)._next;
+			if (pred(node(kept)._val, node(current)._val)) {
+				unlink(current);
+				(removed_tail != sentinel ? node(removed_tail)._next : removed_head) = current;
+				removed_tail = current;
+				++removed;
+			} else {
+				kept = current;
+			}
+			current = next_index;
+		}
+	} catch (...) {
+		flush();
+		throw;
+	}
+
+	flush();
+	return removed;
+}
+
+template <typename ElementType, typename Allocator>
+void CompactDoublyLinkedList<ElementType, Allocator>::clear() {
+	if (_capacity == 0) {
+		return;
+	}
+	release_chain(node(sentinel)._next); // 尾节点的 _next 本来就是哨兵
+	node(sentinel)._prev = sentinel;
+	node(sentinel)._next = sentinel;
+	_size = 0;
+}
+}
+
+
+#endif //COMPACTDOUBLYLINKEDLIST_HPP
@@ -0,0 +1,205 @@
+#ifndef COWDOUBLYLINKEDLIST_HPP
+#define COWDOUBLYLINKEDLIST_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+namespace mystl {
+// 写时复制的 DoublyLinkedList：拷贝只共享同一条节点链，第一次修改时才真正复制。
+// 空链表不持有任何节点链，构造和拷贝都不分配内存。
+// begin()/end() 总是只读的，遍历共享的拷贝不会触发复制；需要原地修改元素时用 mutable_begin()/mutable_end()。
+template <typename ElementType, typename Allocator = std::allocator<ElementType>>
+struct CowDoublyLinkedList {
+public:
+	using List = DoublyLinkedList<ElementType, Allocator>;
+	using iterator = typename List::iterator;
+
+	// 只读迭代器：解引用得到 const 引用，共享的节点链不会经由它被修改
+	class ConstIterator {
+	public:
+		using iterator_concept = std::bidirectional_iterator_tag;
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const ElementType*;
+		using reference = const ElementType&;
+
+		ConstIterator() = default;
+		ConstIterator(iterator it) : _it{it} {}
+
+	public:
+		const ElementType& operator*() const { return *_it; }
+		const ElementType* operator->() const { return _it.operator->(); }
+
+		ConstIterator& operator++() {
+			++_it;
+			return *this;
+		}
+		ConstIterator& operator--() {
+			--_it;
+			return *this;
+		}
+		ConstIterator operator++(int) { return ConstIterator(_it++); }
+		ConstIterator operator--(int) { return ConstIterator(_it--); }
+
+		bool operator==(const ConstIterator& ano_iter) const { return _it == ano_iter._it; }
+
+		iterator base() const { return _it; }
+
+	private:
+		iterator _it;
+	};
+
+	using const_iterator = ConstIterator;
+
+private:
+	std::shared_ptr<List> _list;
+
+	static const List& empty_list();
+	const List& view() const { return _list ? *_list : empty_list(); }
+	List& detach();
+	iterator detach_at(const_iterator it);
+
+public:
+	CowDoublyLinkedList() noexcept = default;
+	explicit CowDoublyLinkedList(uint64_t size);
+	CowDoublyLinkedList(uint64_t size, ElementType val);
+	CowDoublyLinkedList(std::initializer_list<ElementType> list);
+	explicit CowDoublyLinkedList(List list);
+
+	CowDoublyLinkedList(const CowDoublyLinkedList& ano_list) = default;
+	CowDoublyLinkedList& operator=(const CowDoublyLinkedList& ano_list) = default;
+
+	CowDoublyLinkedList(CowDoublyLinkedList&& ano_list) noexcept = default;
+	CowDoublyLinkedList& operator=(CowDoublyLinkedList&& ano_list) noexcept = default;
+
+	~CowDoublyLinkedList() = default;
+
+public:
+	// 默认的遍历（包括范围 for）只读、不分离，迭代器在下一次修改之前有效
+	const_iterator begin() const { return view().begin(); }
+	const_iterator end() const { return view().end(); }
+	const_iterator cbegin() const { return begin(); }
+	const_iterator cend() const { return end(); }
+	// 可写遍历：共享时先完整复制一份私有的节点链（O(n)），迭代器在下一次拷贝或修改之前有效
+	iterator mutable_begin() { return empty() ? view().begin() : detach().begin(); }
+	iterator mutable_end() { return empty() ? view().end() : detach().end(); }
+	ElementType front() const { return view().front(); }
+	ElementType back() const { return view().back(); }
+	[[nodiscard]] uint64_t size() const { return view().size(); }
+	[[nodiscard]] bool empty() const { return view().empty(); }
+	// 是否与其他拷贝共享节点链
+	[[nodiscard]] bool shared() const { return _list && _list.use_count() > 1; }
+
+	void push_front(const ElementType& val) { detach().push_front(val); }
+	void push_back(const ElementType& val) { detach().push_back(val); }
+	iterator insert(const_iterator it, const ElementType& val);
+
+	void pop_back();
+	void pop_front();
+
+	iterator erase(const_iterator it);
+	template <typename Predicate>
+	uint64_t remove_if(Predicate pred) { return empty() ? 0 : detach().remove_if(std::move(pred)); }
+
+	void clear() { _list.reset(); }
+};
+
+template <typename ElementType, typename Allocator>
+const typename CowDoublyLinkedList<ElementType, Allocator>::List&
+CowDoublyLinkedList<ElementType, Allocator>::empty_list() {
+	static const List list;
+	return list;
+}
+
+template <typename ElementType, typename Allocator>
+typename CowDoublyLinkedList<ElementType, Allocator>::List& CowDoublyLinkedList<ElementType, Allocator>::detach() {
+	if (!_list) {
+		_list = std::make_shared<List>();
+	} else if (_list.use_count() > 1) {
+		// 仍有其他拷贝在读这条链：复制一份私有的
+		_list = std::make_shared<List>(*_list);
+	} else {
+		// 独占时，保证其他线程释放引用之前的读取先于这里的写入
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+	return *_list;
+}
+
+template <typename ElementType, typename Allocator>
+typename CowDoublyLinkedList<ElementType, Allocator>::iterator
+CowDoublyLinkedList<ElementType, Allocator>::detach_at(const_iterator it) {
+	if (_list && !shared()) {
+		detach();
+		return it.base();
+	}
+
+	// 迭代器指向共享链（或空链表的静态哨兵），复制后按偏移量在私有链上找到对应位置
+	uint64_t offset = 0;
+	for (auto current = view().begin(); current != it.base(); ++current) {
+		++offset;
+	}
+	auto result = detach().begin();
+	for (uint64_t i = 0; i < offset; ++i) {
+		++result;
+	}
+	return result;
+}
+
+template <typename ElementType, typename Allocator>
+CowDoublyLinkedList<ElementType, Allocator>::CowDoublyLinkedList(uint64_t size) :
+	_list{std::make_shared<List>(size)} {}
+
+template <typename ElementType, typename Allocator>
+CowDoublyLinkedList<ElementType, Allocator>::CowDoublyLinkedList(uint64_t size, ElementType val) :
+	_list{std::make_shared<List>(size, std::move(val))} {}
+
+template <typename ElementType, typename Allocator>
+CowDoublyLinkedList<ElementType, Allocator>::CowDoublyLinkedList(std::initializer_list<ElementType> list) :
+	_list{std::make_shared<List>(list)} {}
+
+template <typename ElementType, typename Allocator>
+CowDoublyLinkedList<ElementType, Allocator>::CowDoublyLinkedList(List list) :
+	_list{std::make_shared<List>(std::move(list))} {}
+
+template <typename ElementType, typename Allocator>
+typename CowDoublyLinkedList<ElementType, Allocator>::iterator
+CowDoublyLinkedList<ElementType, Allocator>::insert(const_iterator it, const ElementType& val) {
+	iterator pos = detach_at(it);
+	_list->insert(pos, val);
+	return --pos;
+}
+
+template <typename ElementType, typename Allocator>
+void CowDoublyLinkedList<ElementType, Allocator>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	detach().pop_back();
+}
+
+template <typename ElementType, typename Allocator>
+void CowDoublyLinkedList<ElementType, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	detach().pop_front();
+}
+
+template <typename ElementType, typename Allocator>
+typename CowDoublyLinkedList<ElementType, Allocator>::iterator
+CowDoublyLinkedList<ElementType, Allocator>::erase(const_iterator it) {
+	const iterator pos = detach_at(it); // 先分离，_list 可能被替换
+	return _list->erase(pos);
+}
+}
+
+
+#endif //COWDOUBLYLINKEDLIST_HPP
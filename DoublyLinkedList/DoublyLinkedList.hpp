@@ -1,27 +1,44 @@
 #ifndef DOUBLYLINKEDLIST_HPP
 #define DOUBLYLINKEDLIST_HPP
 
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <execution>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "ListSort.hpp"
+#include "ListStats.hpp"
 
 namespace mystl {
-template <typename ElementType>
+template <typename ElementType, typename Allocator = std::allocator<ElementType>, typename StatsPolicy = NoListStats>
 struct DoublyLinkedList {
 private:
-	struct LinkedListNode {
-		std::shared_ptr<LinkedListNode> _prev;
-		std::shared_ptr<LinkedListNode> _next;
+	// 哨兵只需要前后链接，不携带元素，因此单独拆出一个基类嵌入链表对象中
+	struct LinkedListNodeBase {
+		LinkedListNodeBase* _prev = nullptr;
+		LinkedListNodeBase* _next = nullptr;
+	};
+
+	struct LinkedListNode : LinkedListNodeBase {
 		ElementType _val;
 
-		LinkedListNode() = default;
+		LinkedListNode() : _val{} {}
 		explicit LinkedListNode(ElementType val);
 
-		LinkedListNode(const LinkedListNode& ano_node) = default;
-		LinkedListNode& operator =(const LinkedListNode& ano_node);
-
-		LinkedListNode(LinkedListNode&& ano_node) noexcept;
-		LinkedListNode& operator =(LinkedListNode&& ano_node) noexcept;
+		LinkedListNode(const LinkedListNode& ano_node) = delete;
+		LinkedListNode& operator =(const LinkedListNode& ano_node) = delete;
 
 		~LinkedListNode() = default;
 	};
@@ -29,40 +46,130 @@ private:
 public:
 	using Node = LinkedListNode;
 
+	using allocator_type = Allocator;
+
 private:
+	using NodeBase = LinkedListNodeBase;
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+
+	using IteratorHook = typename StatsPolicy::IteratorHook;
+
+	// 双向迭代器，满足 std::bidirectional_iterator，可以直接用于 std::ranges 的算法和视图。
+	// 链表首尾都接在哨兵上，从 end() 后退得到最后一个元素，步进不需要任何判断
 	class Iterator {
 	public:
-		std::shared_ptr<Node> _current;
+		using iterator_concept = std::bidirectional_iterator_tag;
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = ElementType*;
+		using reference = ElementType&;
+
+		NodeBase* _current = nullptr;
+		[[no_unique_address]] IteratorHook _hook;
 
 	public:
 		Iterator() = default;
-		explicit Iterator(std::shared_ptr<Node> pt) : _current{pt} {}
+		explicit Iterator(NodeBase* pt) : _current{pt} {}
+		Iterator(NodeBase* pt, IteratorHook hook) : _current{pt}, _hook{std::move(hook)} {}
 
 		Iterator(const Iterator& ano_iter) = default;
-		Iterator& operator=(const Iterator& ano_iter);
+		Iterator& operator=(const Iterator& ano_iter) = default;
 
-		Iterator(Iterator&& ano_iter) noexcept;
-		Iterator& operator=(Iterator&& ano_iter) noexcept;
+		Iterator(Iterator&& ano_iter) noexcept = default;
+		Iterator& operator=(Iterator&& ano_iter) noexcept = default;
 
 		~Iterator() = default;
 
 	public:
-		ElementType& operator*() { return _current->_val; }
-		auto operator->() { return _current; }
+		ElementType& operator*() const { return static_cast<Node*>(_current)->_val; }
+		ElementType* operator->() const { return &static_cast<Node*>(_current)->_val; }
 
-		Iterator operator++();
-		Iterator operator--();
+		Iterator& operator++();
+		Iterator& operator--();
+		Iterator operator++(int);
+		Iterator operator--(int);
 
 		bool operator!=(const Iterator& ano_iter) const { return _current != ano_iter._current; }
 		bool operator==(const Iterator& ano_iter) const { return _current == ano_iter._current; }
 	};
 
+	// 持有一个已摘下节点的句柄，语义同 std::map::node_type
+	class NodeHandle {
+	public:
+		NodeHandle() noexcept = default;
+
+		NodeHandle(const NodeHandle& ano_handle) = delete;
+		NodeHandle& operator=(const NodeHandle& ano_handle) = delete;
+
+		NodeHandle(NodeHandle&& ano_handle) noexcept;
+		NodeHandle& operator=(NodeHandle&& ano_handle) noexcept;
+
+		~NodeHandle() { reset(); }
+
+	public:
+		[[nodiscard]] bool empty() const noexcept { return _node == nullptr; }
+		explicit operator bool() const noexcept { return _node != nullptr; }
+		ElementType& value() const { return _node->_val; }
+		allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+	private:
+		friend struct DoublyLinkedList;
+
+		NodeHandle(Node* node, const NodeAllocator& alloc) noexcept : _node{node}, _alloc{alloc} {}
+		Node* release() noexcept { return std::exchange(_node, nullptr); }
+		void reset() noexcept;
+
+		Node* _node = nullptr;
+		[[no_unique_address]] NodeAllocator _alloc;
+	};
+
+public:
+	using iterator = Iterator;
+	using reverse_iterator = std::reverse_iterator<Iterator>;
+	using value_type = ElementType;
+	using reference = ElementType&;
+	using difference_type = std::ptrdiff_t;
+	using node_type = NodeHandle;
+
 private:
 	uint64_t _size;
-	std::shared_ptr<Node> _sentinel;
+	NodeBase _sentinel;
+	[[no_unique_address]] NodeAllocator _alloc;
+	[[no_unique_address]] mutable StatsPolicy _stats;
+
+	NodeBase* sentinel() const { return const_cast<NodeBase*>(&_sentinel); }
+	Iterator make_iterator(NodeBase* node) const { return Iterator(node, _stats.iterator_hook()); }
+	void reset_sentinel() noexcept;
+	void take_nodes(DoublyLinkedList& ano_list) noexcept;
+	static constexpr bool nothrow_move_assign = NodeAllocTraits::propagate_on_container_move_assignment::value ||
+	                                            NodeAllocTraits::is_always_equal::value;
+
+	template <typename... Args>
+	Node* create_node(Args&&... args);
+	void destroy_node(NodeBase* node) noexcept;
+	uint64_t destroy_chain(NodeBase* first, NodeBase* stop) noexcept;
+	// 分配器能报告尚未归还的块数并一次性收回全部块时（如 ArenaAllocator），clear 可以整体释放节点
+	static constexpr bool bulk_releasable = requires(NodeAllocator& alloc) {
+		{ alloc.live_blocks() } -> std::convertible_to<std::size_t>;
+		alloc.reset();
+	};
+	bool try_release_all() noexcept;
+	std::pair<NodeBase*, NodeBase*> build_chain(std::span<const ElementType> values);
+	void splice_chain(NodeBase* pos, NodeBase* first, NodeBase* last, uint64_t count) noexcept;
+	// 把全部节点摘成一条以 nullptr 结尾的链，_size 不变；adopt_chain 再把这样一条链整体挂回哨兵
+	NodeBase* detach_chain() noexcept;
+	void adopt_chain(NodeBase* first, NodeBase* last) noexcept;
+	// 把划分结果按 “满足的在前” 挂回哨兵，返回第一个不满足的元素
+	Iterator adopt_parts(const list_sort_detail::PartitionParts<NodeBase>& parts) noexcept;
+	// 并行算法实际使用的线程数，每个线程至少分到 parallel_grain 个节点
+	static constexpr uint64_t parallel_grain = 1 << 14;
+	uint32_t parallel_workers(uint32_t threads) const;
 
 public:
-	DoublyLinkedList() = default;
+	DoublyLinkedList() noexcept;
+	explicit DoublyLinkedList(const Allocator& alloc) noexcept;
 	explicit DoublyLinkedList(uint64_t size);
 	DoublyLinkedList(uint64_t size, ElementType val);
 	DoublyLinkedList(const Iterator& begin, const Iterator& end);
@@ -72,322 +179,813 @@ public:
 	DoublyLinkedList& operator=(const DoublyLinkedList& ano_list);
 
 	DoublyLinkedList(DoublyLinkedList&& ano_list) noexcept;
-	DoublyLinkedList& operator=(DoublyLinkedList&& ano_list) noexcept;
+	// 分配器不随移动赋值传播且两者不相等时只能逐个移动元素，这种情况下可能抛出异常
+	DoublyLinkedList& operator=(DoublyLinkedList&& ano_list) noexcept(nothrow_move_assign);
 
-	~DoublyLinkedList() = default;
+	~DoublyLinkedList() { clear(); }
 
 public:
-	Iterator begin() const { return Iterator(_sentinel->_next); }
-	Iterator end() const { return Iterator(_sentinel); }
-	ElementType front() const { return _sentinel->_next->_val; }
-	ElementType back() const { return _sentinel->_prev->_val; }
+	Iterator begin() const { return make_iterator(_sentinel._next); }
+	Iterator end() const { return make_iterator(sentinel()); }
+	reverse_iterator rbegin() const { return reverse_iterator(end()); }
+	reverse_iterator rend() const { return reverse_iterator(begin()); }
+	// [first, last) 这一段的视图，不复制元素
+	std::ranges::subrange<Iterator> subrange(Iterator first, Iterator last) const { return {first, last}; }
+	ElementType front() const { return static_cast<Node*>(_sentinel._next)->_val; }
+	ElementType back() const { return static_cast<Node*>(_sentinel._prev)->_val; }
 	[[nodiscard]] uint64_t size() const { return _size; }
 	[[nodiscard]] bool empty() const { return _size == 0; }
 
 	void push_front(const ElementType& val);
 	void push_back(const ElementType& val);
 	void insert(Iterator it, const ElementType& val);
+	// 句柄的分配器与本链表的不相等时抛出 std::invalid_argument
+	Iterator insert(Iterator it, node_type&& handle);
 
 	void pop_back();
 	void pop_front();
 
+	// 批量接口：整批节点先在链表外串好，再一次性接入或摘下，哨兵和 _size 只更新一次。
+	// push_*_batch 保持 values 中的顺序；pop_*_batch 按弹出顺序写入 out，
+	// 最多弹出 min(n, out.size(), size()) 个并返回实际个数，空链表时返回 0 而不抛异常
+	void push_back_batch(std::span<const ElementType> values);
+	void push_front_batch(std::span<const ElementType> values);
+	uint64_t pop_front_batch(std::span<ElementType> out, uint64_t n);
+	uint64_t pop_back_batch(std::span<ElementType> out, uint64_t n);
+
+	node_type extract(Iterator it);
+
+	Iterator erase(Iterator it);
+	Iterator erase(Iterator first, Iterator last);
+	uint64_t remove(const ElementType& val);
+	template <typename Predicate>
+	uint64_t remove_if(Predicate pred);
+	uint64_t unique();
+	template <typename BinaryPredicate>
+	uint64_t unique(BinaryPredicate pred);
+
+	// 稳定的归并排序，只重新链接节点，不移动也不复制元素，迭代器保持有效。
+	// 比较抛出异常时所有元素仍在链表中，顺序未指定
+	template <typename Compare = std::less<>>
+		requires (!std::is_execution_policy_v<std::remove_cvref_t<Compare>>)
+	void sort(Compare cmp = Compare());
+	// 并行版本：各线程先对按位置切开的一段排序，再按采样得到的分割点切片、各自归并一片后首尾相接。
+	// threads 为 0 时使用全部硬件线程，链表太短时退化为单线程排序。
+	// 与标准库的并行算法一样，比较抛出异常时调用 std::terminate
+	template <typename ExecutionPolicy, typename Compare = std::less<>>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	void sort(ExecutionPolicy&& policy, Compare cmp = Compare(), uint32_t threads = 0);
+
+	// 稳定划分：满足 pred 的元素移到前面，返回指向第一个不满足的元素的迭代器，不移动元素
+	template <typename Predicate>
+		requires (!std::is_execution_policy_v<std::remove_cvref_t<Predicate>>)
+	Iterator stable_partition(Predicate pred);
+	template <typename ExecutionPolicy, typename Predicate>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	Iterator stable_partition(ExecutionPolicy&& policy, Predicate pred, uint32_t threads = 0);
+
+	// 区域分配器里只剩本链表的节点时整块归还，元素可平凡析构时完全不访问节点；否则逐个释放。析构函数同样走这里
 	void clear();
+
+	[[nodiscard]] allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+	// 仅在启用统计策略时可用
+	[[nodiscard]] ListStatsSnapshot stats() const requires StatsPolicy::enabled { return _stats.snapshot(); }
+	void reset_stats() requires StatsPolicy::enabled { _stats.reset(); }
 };
 
-template <typename ElementType>
-using list = DoublyLinkedList<ElementType>;
+template <typename ElementType, typename Allocator = std::allocator<ElementType>, typename StatsPolicy = NoListStats>
+using list = DoublyLinkedList<ElementType, Allocator, StatsPolicy>;
 
-template <typename ElementType>
-using Node = typename DoublyLinkedList<ElementType>::template LinkedListNode<ElementType>;
+template <typename ElementType, typename Allocator = std::allocator<ElementType>, typename StatsPolicy = NoListStats>
+using Node = typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Node;
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::LinkedListNode::LinkedListNode(ElementType val) :
-	_prev{std::shared_ptr<LinkedListNode>()},
-	_next{std::shared_ptr<LinkedListNode>()},
-	_val{val} {}
+// 与 C++20 的 std::erase / std::erase_if 同形，通过 ADL 找到
+template <typename ElementType, typename Allocator, typename StatsPolicy, typename Value>
+uint64_t erase(DoublyLinkedList<ElementType, Allocator, StatsPolicy>& list, const Value& val) {
+	return list.remove_if([&val](const ElementType& elem) { return elem == val; });
+}
 
-template <typename ElementType>
-typename DoublyLinkedList<ElementType>::LinkedListNode&
-DoublyLinkedList<ElementType>::LinkedListNode::operator=(const LinkedListNode& ano_node) {
-	if (this != &ano_node) {
-		_prev = ano_node._prev;
-		_next = ano_node._next;
-		_val = ano_node._val;
-	}
+template <typename ElementType, typename Allocator, typename StatsPolicy, typename Predicate>
+uint64_t erase_if(DoublyLinkedList<ElementType, Allocator, StatsPolicy>& list, Predicate pred) {
+	return list.remove_if(std::move(pred));
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::LinkedListNode::LinkedListNode(ElementType val) :
+	_val{std::move(val)} {}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator&
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator::operator++() {
+	_current = _current->_next;
+	_hook.on_step();
+	return *this;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator&
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator::operator--() {
+	_current = _current->_prev;
+	_hook.on_step();
 	return *this;
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::LinkedListNode::LinkedListNode(LinkedListNode&& ano_node) noexcept :
-	_prev{std::move(ano_node._prev)}, _next{std::move(ano_node._next)}, _val{std::move(ano_node._val)} {}
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator::operator++(int) {
+	Iterator old_iter = *this;
+	++*this;
+	return old_iter;
+}
 
-template <typename ElementType>
-typename DoublyLinkedList<ElementType>::LinkedListNode&
-DoublyLinkedList<ElementType>::LinkedListNode::operator=(LinkedListNode&& ano_node) noexcept {
-	if (this != &ano_node) {
-		_prev = std::move(ano_node._prev);
-		_next = std::move(ano_node._next);
-		_val = std::move(ano_node._val);
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator::operator--(int) {
+	Iterator old_iter = *this;
+	--*this;
+	return old_iter;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::NodeHandle::NodeHandle(NodeHandle&& ano_handle) noexcept :
+	_node{ano_handle.release()}, _alloc{std::move(ano_handle._alloc)} {}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::NodeHandle&
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::NodeHandle::operator=(NodeHandle&& ano_handle) noexcept {
+	if (this != &ano_handle) {
+		reset();
+		_node = ano_handle.release();
+		_alloc = std::move(ano_handle._alloc);
 	}
 	return *this;
 }
 
-template <typename ElementType>
-typename DoublyLinkedList<ElementType>::Iterator&
-DoublyLinkedList<ElementType>::Iterator::operator=(const Iterator& ano_iter) {
-	if (this != &ano_iter) {
-		_current = ano_iter._current;
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::NodeHandle::reset() noexcept {
+	// 句柄被丢弃时节点仍未归还，由句柄负责析构并释放
+	if (_node) {
+		NodeAllocTraits::destroy(_alloc, _node);
+		NodeAllocTraits::deallocate(_alloc, _node, 1);
+		_node = nullptr;
 	}
-	return *this;
 }
 
-template <typename ElementType>
-DoublyLinkedList<
-	ElementType>::Iterator::Iterator(Iterator&& ano_iter) noexcept : _current{std::move(ano_iter._current)} {}
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::reset_sentinel() noexcept {
+	// 空链表的哨兵自成环，所有操作都不需要判空
+	_sentinel._prev = &_sentinel;
+	_sentinel._next = &_sentinel;
+	_size = 0;
+}
 
-template <typename ElementType>
-typename DoublyLinkedList<ElementType>::Iterator& DoublyLinkedList<ElementType>::Iterator::operator=(
-	Iterator&& ano_iter) noexcept {
-	if (this != &ano_iter) {
-		_current = std::move(ano_iter._current);
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::take_nodes(DoublyLinkedList& ano_list) noexcept {
+	if (ano_list.empty()) {
+		reset_sentinel();
+		return;
 	}
-	return *this;
+
+	// 接管节点链，并把首尾节点指向旧哨兵的链接改到本对象的哨兵上
+	_sentinel._next = ano_list._sentinel._next;
+	_sentinel._prev = ano_list._sentinel._prev;
+	_sentinel._next->_prev = &_sentinel;
+	_sentinel._prev->_next = &_sentinel;
+	_size = ano_list._size;
+	_stats.on_attach(_size * sizeof(Node));
+	ano_list._stats.on_detach(_size * sizeof(Node));
+
+	ano_list.reset_sentinel();
 }
 
-template <typename ElementType>
-typename DoublyLinkedList<ElementType>::Iterator DoublyLinkedList<ElementType>::Iterator::operator++() {
-	if (_current) {
-		if (_current->_next) {
-			_current = _current->_next;
-		}
-		else {
-			return Iterator(nullptr);
-		}
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+template <typename... Args>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Node*
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::create_node(Args&&... args) {
+	Node* node = NodeAllocTraits::allocate(_alloc, 1);
+	try {
+		NodeAllocTraits::construct(_alloc, node, std::forward<Args>(args)...);
+	} catch (...) {
+		NodeAllocTraits::deallocate(_alloc, node, 1);
+		throw;
 	}
-	return *this;
+	_stats.on_allocate(sizeof(Node));
+	return node;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::destroy_node(NodeBase* node) noexcept {
+	auto real_node = static_cast<Node*>(node);
+	NodeAllocTraits::destroy(_alloc, real_node);
+	NodeAllocTraits::deallocate(_alloc, real_node, 1);
+	_stats.on_free(sizeof(Node));
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+uint64_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::destroy_chain(NodeBase* first, NodeBase* stop) noexcept {
+	// 沿 _next 释放一整段已经摘下的节点，调用方负责在此之前完成重新链接
+	uint64_t count = 0;
+	while (first != stop) {
+		auto next_node = first->_next;
+		destroy_node(first);
+		first = next_node;
+		++count;
+	}
+	return count;
 }
 
-template <typename ElementType>
-typename DoublyLinkedList<ElementType>::Iterator DoublyLinkedList<ElementType>::Iterator::operator--() {
-	if (_current) {
-		if (_current->_prev) {
-			_current = _current->_prev;
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+bool DoublyLinkedList<ElementType, Allocator, StatsPolicy>::try_release_all() noexcept {
+	if constexpr (bulk_releasable) {
+		// 分配器里还有别的块（其他链表的节点、未归还的 node_type）时不能整体归还
+		if (empty() || _alloc.live_blocks() != _size) {
+			return false;
 		}
-		else {
-			return Iterator(nullptr);
+		if constexpr (!std::is_trivially_destructible_v<Node>) {
+			// 只析构元素、不逐个归还内存；先预取下一个节点，与当前元素的析构重叠
+			NodeBase* node = _sentinel._next;
+			while (node != &_sentinel) {
+				NodeBase* next_node = node->_next;
+				__builtin_prefetch(next_node);
+				NodeAllocTraits::destroy(_alloc, static_cast<Node*>(node));
+				node = next_node;
+			}
 		}
+		_alloc.reset(); // 只重置不归还系统，反复填充再清空时不必重新申请内存
+		_stats.on_free(sizeof(Node), _size);
+		return true;
+	} else {
+		return false;
 	}
-	return *this;
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::DoublyLinkedList(uint64_t size) : _size{size}, _sentinel{std::make_shared<Node>()} {
-	if (size > 0) {
-		auto current = _sentinel;
-		for (uint64_t i = 0; i < size; ++i) {
-			auto new_node = std::make_shared<Node>();
-			current->_next = new_node;
-			new_node->_prev = current;
-			current = new_node;
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+std::pair<typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::NodeBase*,
+          typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::NodeBase*>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::build_chain(std::span<const ElementType> values) {
+	// 在链表外串成一条以 nullptr 结尾的链，中途构造失败时整段释放，链表本身不受影响
+	NodeBase* first = nullptr;
+	NodeBase* last = nullptr;
+	try {
+		for (const auto& val : values) {
+			NodeBase* node = create_node(val);
+			node->_prev = last;
+			node->_next = nullptr;
+			(last ? last->_next : first) = node;
+			last = node;
 		}
-		current->_next = _sentinel;
-		_sentinel->_prev = current;
+	} catch (...) {
+		destroy_chain(first, nullptr);
+		throw;
 	}
+	return {first, last};
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::DoublyLinkedList(uint64_t size, ElementType val) :
-	_size{size}, _sentinel{std::make_shared<Node>()} {
-	if (size > 0) {
-		auto current = _sentinel;
-		for (uint64_t i = 0; i < size; ++i) {
-			auto new_node = std::make_shared<Node>(val);
-			current->_next = new_node;
-			new_node->_prev = current;
-			current = new_node;
-		}
-		current->_next = _sentinel;
-		_sentinel->_prev = current;
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::splice_chain(NodeBase* pos, NodeBase* first, NodeBase* last,
+                                                                         uint64_t count) noexcept {
+	first->_prev = pos->_prev;
+	last->_next = pos;
+	pos->_prev->_next = first;
+	pos->_prev = last;
+	_size += count;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList() noexcept : _size{0}, _sentinel{&_sentinel, &_sentinel} {}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList(const Allocator& alloc) noexcept :
+	_size{0}, _sentinel{&_sentinel, &_sentinel}, _alloc{alloc} {}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList(uint64_t size) : DoublyLinkedList() {
+	for (uint64_t i = 0; i < size; ++i) {
+		auto new_node = create_node();
+		new_node->_prev = _sentinel._prev;
+		new_node->_next = &_sentinel;
+		_sentinel._prev->_next = new_node;
+		_sentinel._prev = new_node;
+		++_size;
+	}
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList(uint64_t size, ElementType val) : DoublyLinkedList() {
+	for (uint64_t i = 0; i < size; ++i) {
+		push_back(val);
 	}
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::DoublyLinkedList(const Iterator& begin, const Iterator& end) :
-	_size{0}, _sentinel{std::make_shared<Node>()} {
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList(const Iterator& begin, const Iterator& end) : DoublyLinkedList() {
 	for (auto it = begin; it != end; ++it) {
 		push_back(*it);
 	}
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::DoublyLinkedList(std::initializer_list<ElementType> list) :
-	_size{0}, _sentinel{nullptr} {
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList(std::initializer_list<ElementType> list) : DoublyLinkedList() {
 	for (const auto& value : list) {
 		push_back(value);
 	}
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::DoublyLinkedList(const DoublyLinkedList& ano_list) :
-	_size{ano_list._size}, _sentinel{nullptr} {
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList(const DoublyLinkedList& ano_list) :
+	DoublyLinkedList(NodeAllocTraits::select_on_container_copy_construction(ano_list._alloc)) {
 	for (auto it = ano_list.begin(); it != ano_list.end(); ++it) {
-		push_back(it->_val);
-		++_size;
+		push_back(*it);
 	}
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>& DoublyLinkedList<ElementType>::operator=(const DoublyLinkedList& ano_list) {
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>& DoublyLinkedList<ElementType, Allocator, StatsPolicy>::operator=(const DoublyLinkedList& ano_list) {
 	if (this != &ano_list) {
 		this->clear();
+		if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value) {
+			_alloc = ano_list._alloc;
+		}
 
 		for (auto it = ano_list.begin(); it != ano_list.end(); ++it) {
 			push_back(*it);
 		}
-
-		_size = ano_list._size;
 	}
 	return *this;
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>::DoublyLinkedList(DoublyLinkedList&& ano_list) noexcept
-	: _size(ano_list._size), _sentinel(std::move(ano_list._sentinel)) {
-	ano_list._size = 0;
-	ano_list._sentinel = nullptr;
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::DoublyLinkedList(DoublyLinkedList&& ano_list) noexcept :
+	DoublyLinkedList(std::move(ano_list._alloc)) {
+	take_nodes(ano_list);
 }
 
-template <typename ElementType>
-DoublyLinkedList<ElementType>& DoublyLinkedList<ElementType>::operator=(DoublyLinkedList&& ano_list) noexcept {
-	if (this != &ano_list) {
-		clear();
-
-		_size = ano_list._size;
-		_sentinel = std::move(ano_list._sentinel);
-
-		ano_list._size = 0;
-		ano_list._sentinel = nullptr;
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>& DoublyLinkedList<ElementType, Allocator, StatsPolicy>::operator=(DoublyLinkedList&& ano_list) noexcept(nothrow_move_assign) {
+	if (this == &ano_list) {
+		return *this;
+	}
+	clear();
+	if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value) {
+		_alloc = std::move(ano_list._alloc);
+	} else if (!(_alloc == ano_list._alloc)) {
+		// 节点属于另一个分配器，不能接管，只能逐个移动元素到本链表的分配器上
+		for (NodeBase* node = ano_list._sentinel._next; node != &ano_list._sentinel; node = node->_next) {
+			Node* new_node = create_node(std::move(static_cast<Node*>(node)->_val));
+			new_node->_prev = _sentinel._prev;
+			new_node->_next = &_sentinel;
+			_sentinel._prev->_next = new_node;
+			_sentinel._prev = new_node;
+			++_size;
+		}
+		ano_list.clear();
+		return *this;
 	}
+	take_nodes(ano_list);
 	return *this;
 }
 
-template <typename ElementType>
-void DoublyLinkedList<ElementType>::push_front(const ElementType& val) {
-	auto new_node = std::make_shared<Node>(val); // 创建新节点
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::push_front(const ElementType& val) {
+	auto new_node = create_node(val); // 创建新节点
 
 	// 更新新节点的指针
-	new_node->_next = _sentinel->_next;
-	new_node->_prev = _sentinel;
+	new_node->_next = _sentinel._next;
+	new_node->_prev = &_sentinel;
 
-	// 如果链表非空，更新原始链表的第一个节点的前驱指针
-	if (_sentinel->_next) {
-		_sentinel->_next->_prev = new_node;
-	}
+	// 空链表时 _sentinel._next 就是哨兵本身，这里同时更新了尾指针
+	_sentinel._next->_prev = new_node;
 
 	// 更新 sentinel 的后继指针和链表大小
-	_sentinel->_next = new_node;
+	_sentinel._next = new_node;
 	_size++;
+	_stats.on_push();
 }
 
-template <typename ElementType>
-void DoublyLinkedList<ElementType>::push_back(const ElementType& val) {
-	auto new_node = std::make_shared<Node>(val); // 创建新节点
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::push_back(const ElementType& val) {
+	auto new_node = create_node(val); // 创建新节点
 
 	// 更新新节点的指针
-	new_node->_prev = _sentinel->_prev;
-	new_node->_next = _sentinel;
+	new_node->_prev = _sentinel._prev;
+	new_node->_next = &_sentinel;
 
-	// 如果链表非空，更新原始链表的最后一个节点的后继指针
-	if (_sentinel->_prev) {
-		_sentinel->_prev->_next = new_node;
-	}
+	// 空链表时 _sentinel._prev 就是哨兵本身，这里同时更新了头指针
+	_sentinel._prev->_next = new_node;
 
 	// 更新 sentinel 的前驱指针和链表大小
-	_sentinel->_prev = new_node;
+	_sentinel._prev = new_node;
 	_size++;
+	_stats.on_push();
 }
 
-template <typename ElementType>
-void DoublyLinkedList<ElementType>::insert(Iterator it, const ElementType& val) {
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::insert(Iterator it, const ElementType& val) {
 	// 创建新节点
-	auto new_node = std::make_shared<Node>(val);
+	auto new_node = create_node(val);
 
 	// 更新新节点的指针
 	new_node->_prev = it._current->_prev;
 	new_node->_next = it._current;
 
-	// 更新前驱节点的后继指针
-	if (it._current->_prev) {
-		it._current->_prev->_next = new_node;
-	}
+	// 更新前驱节点（可能是哨兵）的后继指针
+	it._current->_prev->_next = new_node;
 
 	// 更新当前节点的前驱指针
 	it._current->_prev = new_node;
 
-	// 如果插入位置在链表的开头，更新 sentinel 的后继指针
-	if (it == begin()) {
-		_sentinel->_next = new_node;
-	}
-
 	// 增加链表大小
 	_size++;
+	_stats.on_insert();
 }
 
-template <typename ElementType>
-void DoublyLinkedList<ElementType>::pop_back() {
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::pop_back() {
 	if (empty()) {
 		throw std::out_of_range("Cannot pop from an empty list.");
 	}
 
-	auto to_remove = _sentinel->_prev; // 获取最后一个节点
+	auto to_remove = _sentinel._prev; // 获取最后一个节点
 
-	// 更新 sentinel 的前驱指针
-	_sentinel->_prev = to_remove->_prev;
+	// 摘下最后一个节点，唯一节点时前驱就是哨兵本身
+	_sentinel._prev = to_remove->_prev;
+	to_remove->_prev->_next = &_sentinel;
 
-	// 更新最后一个节点的前驱节点的后继指针
-	if (to_remove->_prev) {
-		to_remove->_prev->_next = _sentinel;
-	} else {
-		_sentinel->_next = _sentinel; // 如果移除的是唯一节点，更新 sentinel 的后继指针
-	}
+	destroy_node(to_remove);
 
 	// 减少链表大小
 	_size--;
+	_stats.on_pop();
 }
 
-template <typename ElementType>
-void DoublyLinkedList<ElementType>::pop_front() {
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::pop_front() {
 	if (empty()) {
 		throw std::out_of_range("Cannot pop from an empty list.");
 	}
 
-	auto to_remove = _sentinel->_next; // 获取第一个节点
+	auto to_remove = _sentinel._next; // 获取第一个节点
 
-	// 更新 sentinel 的后继指针
-	_sentinel->_next = to_remove->_next;
+	// 摘下第一个节点，唯一节点时后继就是哨兵本身
+	_sentinel._next = to_remove->_next;
+	to_remove->_next->_prev = &_sentinel;
 
-	// 更新第一个节点的后继节点的前驱指针
-	if (to_remove->_next) {
-		to_remove->_next->_prev = _sentinel;
-	} else {
-		_sentinel->_prev = _sentinel; // 如果移除的是唯一节点，更新 sentinel 的前驱指针
-	}
+	destroy_node(to_remove);
 
 	// 减少链表大小
 	_size--;
+	_stats.on_pop();
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::push_back_batch(std::span<const ElementType> values) {
+	if (values.empty()) {
+		return;
+	}
+	auto [first, last] = build_chain(values);
+	splice_chain(&_sentinel, first, last, values.size());
+	_stats.on_push(values.size());
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::push_front_batch(std::span<const ElementType> values) {
+	if (values.empty()) {
+		return;
+	}
+	auto [first, last] = build_chain(values);
+	splice_chain(_sentinel._next, first, last, values.size());
+	_stats.on_push(values.size());
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+uint64_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::pop_front_batch(std::span<ElementType> out, uint64_t n) {
+	const uint64_t count = std::min({n, static_cast<uint64_t>(out.size()), _size});
+	if (count == 0) {
+		return 0;
+	}
+
+	// 先在链上移出元素，移动抛异常时链表结构保持完整
+	NodeBase* first = _sentinel._next;
+	NodeBase* stop = first;
+	for (uint64_t i = 0; i < count; ++i) {
+		out[i] = std::move(static_cast<Node*>(stop)->_val);
+		stop = stop->_next;
+	}
+
+	_sentinel._next = stop;
+	stop->_prev = &_sentinel;
+	_size -= count;
+	destroy_chain(first, stop);
+	_stats.on_pop(count);
+	return count;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+uint64_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::pop_back_batch(std::span<ElementType> out, uint64_t n) {
+	const uint64_t count = std::min({n, static_cast<uint64_t>(out.size()), _size});
+	if (count == 0) {
+		return 0;
+	}
+
+	NodeBase* first = &_sentinel;
+	for (uint64_t i = 0; i < count; ++i) {
+		first = first->_prev;
+		out[i] = std::move(static_cast<Node*>(first)->_val);
+	}
+
+	// first 到哨兵之间就是要摘下的一段，它的最后一个节点本来就指向哨兵
+	_sentinel._prev = first->_prev;
+	first->_prev->_next = &_sentinel;
+	_size -= count;
+	destroy_chain(first, &_sentinel);
+	_stats.on_pop(count);
+	return count;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::insert(Iterator it, node_type&& handle) {
+	if (handle.empty()) {
+		return it;
+	}
+	if constexpr (!NodeAllocTraits::is_always_equal::value) {
+		// 节点以后由本链表的分配器释放，必须来自相等的分配器；失败时句柄保持不变
+		if (!(handle._alloc == _alloc)) {
+			throw std::invalid_argument("Node handle was allocated by an unequal allocator.");
+		}
+	}
+
+	// 直接把句柄中的节点链入，不分配内存，也不触碰元素本身
+	NodeBase* node = handle.release();
+	node->_prev = it._current->_prev;
+	node->_next = it._current;
+	it._current->_prev->_next = node;
+	it._current->_prev = node;
+
+	_size++;
+	_stats.on_insert();
+	_stats.on_attach(sizeof(Node));
+	return make_iterator(node);
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::node_type
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::extract(Iterator it) {
+	// 只摘链不释放，节点的所有权转交给句柄
+	it._current->_prev->_next = it._current->_next;
+	it._current->_next->_prev = it._current->_prev;
+	it._current->_prev = nullptr;
+	it._current->_next = nullptr;
+
+	_size--;
+	_stats.on_erase(1);
+	_stats.on_detach(sizeof(Node));
+	return node_type(static_cast<Node*>(it._current), _alloc);
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::erase(Iterator it) {
+	auto next_node = it._current->_next;
+
+	// 摘下当前节点
+	it._current->_prev->_next = next_node;
+	next_node->_prev = it._current->_prev;
+
+	destroy_node(it._current);
+	_size--;
+	_stats.on_erase(1);
+	return make_iterator(next_node);
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::erase(Iterator first, Iterator last) {
+	if (first == last) {
+		return last;
+	}
+
+	// 整段一次性摘下：只修改区间两端的两条链接
+	auto before = first._current->_prev;
+	before->_next = last._current;
+	last._current->_prev = before;
+
+	// 再沿原来的 _next 把整段节点批量释放
+	const uint64_t removed = destroy_chain(first._current, last._current);
+	_size -= removed;
+	_stats.on_erase(removed);
+	return last;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+uint64_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::remove(const ElementType& val) {
+	// val 可能引用链表中的元素，节点延迟到遍历结束后才释放，因此可以安全比较
+	return remove_if([&val](const ElementType& elem) { return elem == val; });
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+template <typename Predicate>
+uint64_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::remove_if(Predicate pred) {
+	// 被删除的节点借用 _next 串成一条待释放链，遍历结束后统一释放
+	NodeBase removed_head;
+	NodeBase* removed_tail = &removed_head;
+	uint64_t removed = 0;
+
+	try {
+		auto current = _sentinel._next;
+		while (current != &_sentinel) {
+			auto next_node = current->_next;
+			if (pred(static_cast<Node*>(current)->_val)) {
+				// 就地摘下，链表在任何时刻都保持完整
+				current->_prev->_next = next_node;
+				next_node->_prev = current->_prev;
+
+				removed_tail->_next = current;
+				removed_tail = current;
+				++removed;
+			}
+			current = next_node;
+		}
+	} catch (...) {
+		removed_tail->_next = nullptr;
+		_size -= destroy_chain(removed_head._next, nullptr);
+		throw;
+	}
+
+	removed_tail->_next = nullptr;
+	_size -= destroy_chain(removed_head._next, nullptr);
+	_stats.on_erase(removed);
+	return removed;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+uint64_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::unique() {
+	return unique([](const ElementType& lhs, const ElementType& rhs) { return lhs == rhs; });
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+template <typename BinaryPredicate>
+uint64_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::unique(BinaryPredicate pred) {
+	if (_size < 2) {
+		return 0;
+	}
+
+	// 与 remove_if 相同：连续重复的节点先摘下串起来，最后统一释放
+	NodeBase removed_head;
+	NodeBase* removed_tail = &removed_head;
+	uint64_t removed = 0;
+
+	try {
+		auto kept = _sentinel._next;
+		auto current = kept->_next;
+		while (current != &_sentinel) {
+			auto next_node = current->_next;
+			if (pred(static_cast<Node*>(kept)->_val, static_cast<Node*>(current)->_val)) {
+				kept->_next = next_node;
+				next_node->_prev = kept;
+
+				removed_tail->_next = current;
+				removed_tail = current;
+				++removed;
+			} else {
+				kept = current;
+			}
+			current = next_node;
+		}
+	} catch (...) {
+		removed_tail->_next = nullptr;
+		_size -= destroy_chain(removed_head._next, nullptr);
+		throw;
+	}
+
+	removed_tail->_next = nullptr;
+	_size -= destroy_chain(removed_head._next, nullptr);
+	_stats.on_erase(removed);
+	return removed;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::NodeBase*
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::detach_chain() noexcept {
+	if (empty()) {
+		return nullptr;
+	}
+	NodeBase* first = _sentinel._next;
+	_sentinel._prev->_next = nullptr;
+	_sentinel._next = &_sentinel;
+	_sentinel._prev = &_sentinel;
+	return first;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::adopt_chain(NodeBase* first, NodeBase* last) noexcept {
+	if (!first) {
+		return;
+	}
+	first->_prev = &_sentinel;
+	last->_next = &_sentinel;
+	_sentinel._next = first;
+	_sentinel._prev = last;
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::adopt_parts(const list_sort_detail::PartitionParts<NodeBase>& parts) noexcept {
+	if (parts.true_tail) {
+		parts.true_tail->_next = parts.false_head;
+	}
+	if (parts.false_head) {
+		parts.false_head->_prev = parts.true_tail;
+	}
+	adopt_chain(parts.true_head ? parts.true_head : parts.false_head, parts.false_tail ? parts.false_tail : parts.true_tail);
+	return make_iterator(parts.false_head ? parts.false_head : sentinel());
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+uint32_t DoublyLinkedList<ElementType, Allocator, StatsPolicy>::parallel_workers(uint32_t threads) const {
+	if (threads == 0) {
+		threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	return static_cast<uint32_t>(std::clamp<uint64_t>(_size / parallel_grain, 1, threads));
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+template <typename Compare>
+	requires (!std::is_execution_policy_v<std::remove_cvref_t<Compare>>)
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::sort(Compare cmp) {
+	auto less = [&cmp](const NodeBase* a, const NodeBase* b) {
+		return cmp(static_cast<const Node*>(a)->_val, static_cast<const Node*>(b)->_val);
+	};
+	NodeBase* chain = detach_chain();
+	try {
+		list_sort_detail::sort_chain(chain, less);
+	} catch (...) {
+		adopt_chain(chain, list_sort_detail::link_prev(chain));
+		throw;
+	}
+	adopt_chain(chain, list_sort_detail::link_prev(chain));
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+template <typename ExecutionPolicy, typename Compare>
+	requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::sort(ExecutionPolicy&&, Compare cmp, uint32_t threads) {
+	const uint32_t workers = parallel_workers(threads);
+	if (std::is_same_v<std::remove_cvref_t<ExecutionPolicy>, std::execution::sequenced_policy> || workers <= 1) {
+		sort(cmp);
+		return;
+	}
+
+	auto less = [&cmp](const NodeBase* a, const NodeBase* b) {
+		return cmp(static_cast<const Node*>(a)->_val, static_cast<const Node*>(b)->_val);
+	};
+	list_sort_detail::ParallelChainSort<NodeBase, decltype(less)> sorter(_size, workers, less); // 分配失败时链表不受影响
+	auto [first, last] = sorter.run(detach_chain(), _size);
+	adopt_chain(first, last);
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+template <typename Predicate>
+	requires (!std::is_execution_policy_v<std::remove_cvref_t<Predicate>>)
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::stable_partition(Predicate pred) {
+	auto test = [&pred](const NodeBase* node) { return static_cast<bool>(pred(static_cast<const Node*>(node)->_val)); };
+	NodeBase* chain = detach_chain();
+	list_sort_detail::PartitionParts<NodeBase> parts;
+	try {
+		parts = list_sort_detail::partition_chain(chain, test);
+	} catch (...) {
+		adopt_chain(chain, list_sort_detail::link_prev(chain));
+		throw;
+	}
+	return adopt_parts(parts);
+}
+
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+template <typename ExecutionPolicy, typename Predicate>
+	requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+typename DoublyLinkedList<ElementType, Allocator, StatsPolicy>::Iterator
+DoublyLinkedList<ElementType, Allocator, StatsPolicy>::stable_partition(ExecutionPolicy&&, Predicate pred, uint32_t threads) {
+	const uint32_t workers = parallel_workers(threads);
+	if (std::is_same_v<std::remove_cvref_t<ExecutionPolicy>, std::execution::sequenced_policy> || workers <= 1) {
+		return stable_partition(pred);
+	}
+
+	auto test = [&pred](const NodeBase* node) { return static_cast<bool>(pred(static_cast<const Node*>(node)->_val)); };
+	std::vector<NodeBase*> heads(workers);
+	std::vector<uint64_t> sizes(workers);
+	std::vector<list_sort_detail::PartitionParts<NodeBase>> parts(workers);
+	return adopt_parts(list_sort_detail::parallel_partition_chain(detach_chain(), _size, std::span<NodeBase*>(heads),
+	                                                              std::span<uint64_t>(sizes), std::span(parts), test));
 }
 
-template <typename ElementType>
-void DoublyLinkedList<ElementType>::clear() {
-	auto current = _sentinel->_next; // 从第一个节点开始
-	while (current != _sentinel) { // 直到到达 sentinel
-		auto next_node = current->_next; // 暂存下一个节点
-		current.reset(); // 释放当前节点
-		current = next_node; // 移动到下一个节点
+template <typename ElementType, typename Allocator, typename StatsPolicy>
+void DoublyLinkedList<ElementType, Allocator, StatsPolicy>::clear() {
+	if (!try_release_all()) {
+		destroy_chain(_sentinel._next, &_sentinel); // 从第一个节点释放到 sentinel 为止
 	}
-	_sentinel->_next = _sentinel; // 重置 sentinel 的后继指针
-	_sentinel->_prev = _sentinel; // 重置 sentinel 的前驱指针
-	_size = 0; // 重置大小
+	reset_sentinel(); // 重置 sentinel 的前后指针和大小
 }
 }
 
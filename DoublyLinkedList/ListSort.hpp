@@ -0,0 +1,424 @@
+#ifndef LISTSORT_HPP
+#define LISTSORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mystl {
+// DoublyLinkedList::sort 与 stable_partition 的实现，只改写节点的 _prev/_next，从不移动或复制元素。
+// 处理中的链都以 nullptr 结尾；less(a, b) 与 pred(a) 接收节点指针，由链表负责取出元素
+namespace list_sort_detail {
+// 重建从 head 开始的整条链的 _prev，返回尾节点
+template <typename NodeBase>
+NodeBase* link_prev(NodeBase* head) noexcept {
+	NodeBase* tail = nullptr;
+	for (NodeBase* node = head; node; node = node->_next) {
+		node->_prev = tail;
+		tail = node;
+	}
+	return tail;
+}
+
+// 把 b 接在 a 之后，只在异常路径上使用，需要从头找到 a 的尾
+template <typename NodeBase>
+NodeBase* concat(NodeBase* a, NodeBase* b) noexcept {
+	if (!a) {
+		return b;
+	}
+	NodeBase* tail = a;
+	while (tail->_next) {
+		tail = tail->_next;
+	}
+	tail->_next = b;
+	return a;
+}
+
+// 稳定地合并两条有序链，成功时 a、b 都被置空。
+// 比较抛出异常时，已合并的部分和两条链的剩余部分串成一条放回 a，b 置空后继续抛出，
+// 因此任何时刻所有节点都挂在调用方持有的某条链上
+template <typename NodeBase, typename Less>
+NodeBase* merge(NodeBase*& a, NodeBase*& b, Less& less) {
+	NodeBase head{};
+	NodeBase* tail = &head;
+	try {
+		while (a && b) {
+			if (less(b, a)) {
+				tail->_next = b;
+				b = b->_next;
+			} else {
+				tail->_next = a;
+				a = a->_next;
+			}
+			tail = tail->_next;
+		}
+	} catch (...) {
+		tail->_next = nullptr;
+		a = concat(concat(head._next, a), b);
+		b = nullptr;
+		throw;
+	}
+	tail->_next = a ? a : b;
+	a = nullptr;
+	b = nullptr;
+	return head._next;
+}
+
+// 自底向上的归并排序，第 i 个桶存放 2^i 个节点的有序链，桶号越大元素在原链中越靠前。
+// 比较抛出异常时所有节点以未指定的顺序串回 chain
+template <typename NodeBase, typename Less>
+void sort_chain(NodeBase*& chain, Less& less) {
+	NodeBase* bins[64] = {};
+	NodeBase* carry = nullptr;
+	NodeBase* result = nullptr;
+	try {
+		while (chain) {
+			carry = chain;
+			chain = chain->_next;
+			carry->_next = nullptr;
+			uint32_t i = 0;
+			for (; bins[i]; ++i) {
+				carry = merge(bins[i], carry, less);
+			}
+			bins[i] = carry;
+			carry = nullptr;
+		}
+		for (auto& bin : bins) {
+			if (bin) {
+				result = merge(bin, result, less);
+			}
+		}
+		chain = result;
+	} catch (...) {
+		NodeBase* all = concat(concat(chain, carry), result);
+		for (auto& bin : bins) {
+			all = concat(all, bin);
+		}
+		chain = all;
+		throw;
+	}
+}
+
+template <typename NodeBase>
+struct PartitionParts {
+	NodeBase* true_head = nullptr;
+	NodeBase* true_tail = nullptr;
+	NodeBase* false_head = nullptr;
+	NodeBase* false_tail = nullptr;
+};
+
+template <typename NodeBase>
+void append(NodeBase*& head, NodeBase*& tail, NodeBase* node) noexcept {
+	node->_prev = tail;
+	node->_next = nullptr;
+	(tail ? tail->_next : head) = node;
+	tail = node;
+}
+
+// 稳定划分，两条结果链的 _prev 都已重建。谓词抛出异常时
+// 所有节点按 “满足的、不满足的、未处理的” 顺序串回 chain
+template <typename NodeBase, typename Predicate>
+PartitionParts<NodeBase> partition_chain(NodeBase*& chain, Predicate& pred) {
+	PartitionParts<NodeBase> parts;
+	try {
+		while (chain) {
+			NodeBase* node = chain;
+			const bool keep = pred(node);
+			chain = node->_next;
+			if (keep) {
+				append(parts.true_head, parts.true_tail, node);
+			} else {
+				append(parts.false_head, parts.false_tail, node);
+			}
+		}
+	} catch (...) {
+		if (parts.false_tail) {
+			parts.false_tail->_next = chain;
+			chain = parts.false_head;
+		}
+		if (parts.true_tail) {
+			parts.true_tail->_next = chain;
+			chain = parts.true_head;
+		}
+		throw;
+	}
+	return parts;
+}
+
+// 在 workers 个线程上执行 fn(0) .. fn(workers - 1)，fn(0) 在调用线程上执行。
+// 创建不了线程时那一份改在调用线程上执行，所以这里不会因为线程资源不足而失败
+template <typename Function>
+void run_workers(uint32_t workers, const Function& fn) {
+	std::vector<std::thread> threads;
+	try {
+		threads.reserve(workers - 1);
+	} catch (...) {
+	}
+	for (uint32_t worker = 1; worker < workers; ++worker) {
+		try {
+			threads.emplace_back(std::cref(fn), worker);
+		} catch (...) {
+			fn(worker);
+		}
+	}
+	fn(0);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+// 把以 nullptr 结尾、共 count 个节点的链按位置切成 runs.size() 段，写入各段的首节点和长度
+template <typename NodeBase>
+void split_runs(NodeBase* chain, uint64_t count, std::span<NodeBase*> heads, std::span<uint64_t> sizes) noexcept {
+	const uint64_t runs = heads.size();
+	NodeBase* node = chain;
+	for (uint64_t run = 0; run < runs; ++run) {
+		const uint64_t size = count / runs + (run < count % runs ? 1 : 0);
+		heads[run] = node;
+		sizes[run] = size;
+		for (uint64_t i = 1; i < size; ++i) {
+			node = node->_next;
+		}
+		NodeBase* next_node = node->_next;
+		node->_next = nullptr;
+		node = next_node;
+	}
+}
+
+// 并行归并排序：
+// 1. 链按位置切成 W 段，每个线程对一段做 sort_chain，同时重建 _prev 并每隔 sample_stride 个节点采样；
+// 2. 从样本中选出 W - 1 个分割点，键为 (元素, 段号, 段内位置)，相等的元素也能被均匀切开且保持稳定；
+// 3. 每个线程在样本上二分、再走不超过 sample_stride 步，找到分割点在本段中的位置并把本段切成 W 片；
+// 4. 第 j 个线程按段号顺序两两归并所有段的第 j 片，结果依次拼接即为整体有序。
+// 所有内存在构造时分配，run 本身不分配，比较抛出异常时调用 std::terminate
+template <typename NodeBase, typename Less>
+class ParallelChainSort {
+	static constexpr uint64_t sample_stride = 64;
+	static constexpr uint64_t oversample = 16; // 每段贡献的候选分割点个数
+
+	struct Splitter {
+		NodeBase* node;
+		uint32_t run;
+		uint64_t pos;
+	};
+
+	Less& _less;
+	uint32_t _workers;
+	std::vector<NodeBase*> _run_heads;
+	std::vector<uint64_t> _run_sizes;
+	std::vector<std::vector<NodeBase*>> _samples;
+	std::vector<Splitter> _candidates;
+	std::vector<Splitter> _splitters;
+	std::vector<NodeBase*> _cuts;     // [run * (W + 1) + j]：第 run 段中第 j 片的首节点
+	std::vector<uint64_t> _cut_pos;   // 对应的段内位置，第 W 项是段长
+	std::vector<NodeBase*> _pieces;   // [worker * W + run]：第 worker 个线程要归并的各片
+	std::vector<NodeBase*> _out_heads;
+	std::vector<NodeBase*> _out_tails;
+
+	uint64_t cut_index(uint32_t run, uint32_t slice) const { return run * (_workers + 1) + slice; }
+
+	void sort_run(uint32_t run) noexcept;
+	void choose_splitters() noexcept;
+	void cut_run(uint32_t run) noexcept;
+	void merge_slice(uint32_t worker) noexcept;
+
+public:
+	// 只分配内存，不触碰链表
+	ParallelChainSort(uint64_t count, uint32_t workers, Less& less);
+
+	// 排序以 nullptr 结尾、共 count 个节点的链，返回首尾节点，_prev 已重建
+	std::pair<NodeBase*, NodeBase*> run(NodeBase* chain, uint64_t count) noexcept;
+};
+
+template <typename NodeBase, typename Less>
+ParallelChainSort<NodeBase, Less>::ParallelChainSort(uint64_t count, uint32_t workers, Less& less) :
+	_less{less}, _workers{workers}, _run_heads(workers), _run_sizes(workers), _samples(workers),
+	_splitters(workers - 1), _cuts(workers * (workers + 1)), _cut_pos(workers * (workers + 1)),
+	_pieces(workers * workers), _out_heads(workers), _out_tails(workers) {
+	for (auto& samples : _samples) {
+		samples.reserve(count / workers / sample_stride + 2);
+	}
+	_candidates.reserve(workers * oversample);
+}
+
+template <typename NodeBase, typename Less>
+void ParallelChainSort<NodeBase, Less>::sort_run(uint32_t run) noexcept {
+	NodeBase* head = _run_heads[run];
+	sort_chain(head, _less);
+	_run_heads[run] = head;
+
+	auto& samples = _samples[run];
+	samples.clear();
+	NodeBase* prev_node = nullptr;
+	uint64_t pos = 0;
+	for (NodeBase* node = head; node; node = node->_next, ++pos) {
+		node->_prev = prev_node;
+		prev_node = node;
+		if (pos % sample_stride == 0) {
+			samples.push_back(node);
+		}
+	}
+}
+
+template <typename NodeBase, typename Less>
+void ParallelChainSort<NodeBase, Less>::choose_splitters() noexcept {
+	_candidates.clear();
+	for (uint32_t run = 0; run < _workers; ++run) {
+		const auto& samples = _samples[run];
+		const uint64_t take = std::min<uint64_t>(samples.size(), oversample);
+		for (uint64_t i = 0; i < take; ++i) {
+			const uint64_t index = i * samples.size() / take;
+			_candidates.push_back(Splitter{samples[index], run, index * sample_stride});
+		}
+	}
+	std::sort(_candidates.begin(), _candidates.end(), [this](const Splitter& a, const Splitter& b) {
+		if (_less(a.node, b.node)) {
+			return true;
+		}
+		if (_less(b.node, a.node)) {
+			return false;
+		}
+		return std::tie(a.run, a.pos) < std::tie(b.run, b.pos);
+	});
+	for (uint32_t j = 1; j < _workers; ++j) {
+		_splitters[j - 1] = _candidates[j * _candidates.size() / _workers];
+	}
+}
+
+template <typename NodeBase, typename Less>
+void ParallelChainSort<NodeBase, Less>::cut_run(uint32_t run) noexcept {
+	const auto& samples = _samples[run];
+	_cuts[cut_index(run, 0)] = _run_heads[run];
+	_cut_pos[cut_index(run, 0)] = 0;
+	_cuts[cut_index(run, _workers)] = nullptr;
+	_cut_pos[cut_index(run, _workers)] = _run_sizes[run];
+
+	for (uint32_t j = 1; j < _workers; ++j) {
+		const Splitter& splitter = _splitters[j - 1];
+		// 本段中 (元素, run, 位置) 不小于分割点的第一个节点
+		auto at_or_after = [&](NodeBase* node, uint64_t pos) {
+			if (_less(node, splitter.node)) {
+				return false;
+			}
+			if (_less(splitter.node, node)) {
+				return true;
+			}
+			return run > splitter.run || (run == splitter.run && pos >= splitter.pos);
+		};
+
+		uint64_t low = 0;
+		uint64_t high = samples.size();
+		while (low < high) {
+			const uint64_t mid = (low + high) / 2;
+			if (at_or_after(samples[mid], mid * sample_stride)) {
+				high = mid;
+			} else {
+				low = mid + 1;
+			}
+		}
+
+		NodeBase* node = _run_heads[run];
+		uint64_t pos = 0;
+		if (low > 0) {
+			node = samples[low - 1];
+			pos = (low - 1) * sample_stride;
+			while (node && !at_or_after(node, pos)) {
+				node = node->_next;
+				++pos;
+			}
+		}
+		_cuts[cut_index(run, j)] = node;
+		_cut_pos[cut_index(run, j)] = pos;
+	}
+
+	// 在本段内断开各片，只改写本段的节点
+	for (uint32_t j = 1; j < _workers; ++j) {
+		NodeBase* node = _cuts[cut_index(run, j)];
+		if (node && node->_prev) {
+			node->_prev->_next = nullptr;
+		}
+	}
+}
+
+template <typename NodeBase, typename Less>
+void ParallelChainSort<NodeBase, Less>::merge_slice(uint32_t worker) noexcept {
+	NodeBase** pieces = _pieces.data() + worker * _workers;
+	for (uint32_t run = 0; run < _workers; ++run) {
+		const bool empty = _cut_pos[cut_index(run, worker)] == _cut_pos[cut_index(run, worker + 1)];
+		pieces[run] = empty ? nullptr : _cuts[cut_index(run, worker)];
+	}
+
+	// 相邻的片两两归并，左边的段号更小，保持稳定
+	for (uint32_t width = 1; width < _workers; width *= 2) {
+		for (uint32_t i = 0; i + width < _workers; i += 2 * width) {
+			NodeBase* merged = merge(pieces[i], pieces[i + width], _less);
+			pieces[i] = merged;
+		}
+	}
+	_out_heads[worker] = pieces[0];
+	_out_tails[worker] = link_prev(pieces[0]);
+}
+
+template <typename NodeBase, typename Less>
+std::pair<NodeBase*, NodeBase*> ParallelChainSort<NodeBase, Less>::run(NodeBase* chain, uint64_t count) noexcept {
+	split_runs(chain, count, std::span<NodeBase*>(_run_heads), std::span<uint64_t>(_run_sizes));
+	run_workers(_workers, [this](uint32_t worker) { sort_run(worker); });
+	choose_splitters();
+	run_workers(_workers, [this](uint32_t worker) { cut_run(worker); });
+	run_workers(_workers, [this](uint32_t worker) { merge_slice(worker); });
+
+	NodeBase* first = nullptr;
+	NodeBase* last = nullptr;
+	for (uint32_t worker = 0; worker < _workers; ++worker) {
+		if (!_out_heads[worker]) {
+			continue;
+		}
+		_out_heads[worker]->_prev = last;
+		(last ? last->_next : first) = _out_heads[worker];
+		last = _out_tails[worker];
+	}
+	return {first, last};
+}
+
+// 并行稳定划分：链按位置切成 parts.size() 段，各线程独立划分自己的段，
+// 然后把所有 “满足” 链按段号拼在前面、所有 “不满足” 链拼在后面。
+// heads、sizes 与 parts 等长，由调用方预先分配；谓词抛出异常时调用 std::terminate
+template <typename NodeBase, typename Predicate>
+PartitionParts<NodeBase> parallel_partition_chain(NodeBase* chain, uint64_t count, std::span<NodeBase*> heads,
+                                                  std::span<uint64_t> sizes, std::span<PartitionParts<NodeBase>> parts,
+                                                  Predicate& pred) noexcept {
+	const uint32_t workers = static_cast<uint32_t>(parts.size());
+	split_runs(chain, count, heads, sizes);
+
+	run_workers(workers, [&](uint32_t worker) {
+		NodeBase* run_chain = heads[worker];
+		parts[worker] = partition_chain(run_chain, pred);
+	});
+
+	PartitionParts<NodeBase> result;
+	auto link = [](NodeBase*& head, NodeBase*& tail, NodeBase* part_head, NodeBase* part_tail) {
+		if (!part_head) {
+			return;
+		}
+		part_head->_prev = tail;
+		(tail ? tail->_next : head) = part_head;
+		tail = part_tail;
+	};
+	for (const auto& part : parts) {
+		link(result.true_head, result.true_tail, part.true_head, part.true_tail);
+	}
+	for (const auto& part : parts) {
+		link(result.false_head, result.false_tail, part.false_head, part.false_tail);
+	}
+	return result;
+}
+}
+}
+
+
+#endif //LISTSORT_HPP
@@ -0,0 +1,123 @@
+#ifndef LISTSTATS_HPP
+#define LISTSTATS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+namespace mystl {
+// 某一时刻的统计快照，字段都是普通整数，可以直接导出
+struct ListStatsSnapshot {
+	uint64_t pushes = 0;
+	uint64_t pops = 0;
+	uint64_t inserts = 0;
+	uint64_t erases = 0;
+	uint64_t node_allocations = 0;
+	uint64_t node_frees = 0;
+	uint64_t bytes_held = 0;
+	uint64_t iterator_steps = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const ListStatsSnapshot& stats) {
+	return os << "pushes=" << stats.pushes
+	          << " pops=" << stats.pops
+	          << " inserts=" << stats.inserts
+	          << " erases=" << stats.erases
+	          << " node_allocations=" << stats.node_allocations
+	          << " node_frees=" << stats.node_frees
+	          << " bytes_held=" << stats.bytes_held
+	          << " iterator_steps=" << stats.iterator_steps;
+}
+
+// 默认策略：所有钩子都是空函数，空对象配合 [[no_unique_address]] 不占空间
+struct NoListStats {
+	static constexpr bool enabled = false;
+
+	struct IteratorHook {
+		void on_step() const noexcept {}
+	};
+
+	IteratorHook iterator_hook() const noexcept { return {}; }
+
+	void on_push(uint64_t = 1) noexcept {}
+	void on_pop(uint64_t = 1) noexcept {}
+	void on_insert() noexcept {}
+	void on_erase(uint64_t) noexcept {}
+	void on_allocate(uint64_t) noexcept {}
+	void on_free(uint64_t, uint64_t = 1) noexcept {}
+	void on_attach(uint64_t) noexcept {}
+	void on_detach(uint64_t) noexcept {}
+};
+
+// 计数策略：与链表本身一样不是线程安全的，由持有链表的一方负责同步。
+// 例外是迭代器步数：只读遍历可以在多个线程上并发进行，迭代器又可能比链表活得更久（链表被移动后析构），
+// 所以步数放在迭代器共同持有的原子计数器里，计数器在第一次取迭代器时创建
+struct ListStats {
+	static constexpr bool enabled = true;
+
+	struct IteratorHook {
+		std::shared_ptr<std::atomic<uint64_t>> _steps;
+
+		void on_step() const noexcept {
+			if (_steps) {
+				_steps->fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	IteratorHook iterator_hook() const {
+		auto steps = _steps.load(std::memory_order_acquire);
+		if (!steps) {
+			auto fresh = std::make_shared<std::atomic<uint64_t>>(0);
+			// 并发创建时只有一个能装上，失败的一方拿到胜者的计数器
+			if (_steps.compare_exchange_strong(steps, fresh, std::memory_order_acq_rel)) {
+				steps = std::move(fresh);
+			}
+		}
+		return {std::move(steps)};
+	}
+
+	void on_push(uint64_t count = 1) noexcept { _data.pushes += count; }
+	void on_pop(uint64_t count = 1) noexcept { _data.pops += count; }
+	void on_insert() noexcept { ++_data.inserts; }
+	void on_erase(uint64_t count) noexcept { _data.erases += count; }
+
+	void on_allocate(uint64_t bytes) noexcept {
+		++_data.node_allocations;
+		_data.bytes_held += bytes;
+	}
+
+	void on_free(uint64_t bytes, uint64_t count = 1) noexcept {
+		_data.node_frees += count;
+		_data.bytes_held -= bytes * count;
+	}
+
+	// 节点在链表之间转移（移动、extract/insert）时只改变持有字节数
+	void on_attach(uint64_t bytes) noexcept { _data.bytes_held += bytes; }
+	void on_detach(uint64_t bytes) noexcept { _data.bytes_held -= bytes; }
+
+	[[nodiscard]] ListStatsSnapshot snapshot() const noexcept {
+		ListStatsSnapshot snapshot = _data;
+		if (const auto steps = _steps.load(std::memory_order_acquire)) {
+			snapshot.iterator_steps = steps->load(std::memory_order_relaxed);
+		}
+		return snapshot;
+	}
+
+	// 清零计数器，bytes_held 反映当前状态，保留不变
+	void reset() noexcept {
+		_data = ListStatsSnapshot{.bytes_held = _data.bytes_held};
+		if (const auto steps = _steps.load(std::memory_order_acquire)) {
+			steps->store(0, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	ListStatsSnapshot _data;
+	mutable std::atomic<std::shared_ptr<std::atomic<uint64_t>>> _steps;
+};
+}
+
+
+#endif //LISTSTATS_HPP
@@ -0,0 +1,448 @@
+#ifndef DURABLELIST_HPP
+#define DURABLELIST_HPP
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+namespace mystl {
+struct DurabilityOptions {
+	uint64_t sync_every = 64;               // 攒够多少条日志做一次 write + fdatasync（组提交）
+	uint64_t checkpoint_every = 1 << 20;    // 日志达到多少条时自动做一次检查点，0 表示不自动做
+};
+
+// 带预写日志的持久化链表，可以当作崩溃后可恢复的任务队列使用。
+// 每个修改先编码成一条定长、带校验和的日志记录追加到缓冲区，每 sync_every 条统一写入并 fdatasync，
+// 因此崩溃时最多丢失最后一个未提交批次；需要立即持久化时调用 sync()。
+// 检查点把整条链表写成快照并切换到新一代日志文件，打开目录时加载快照再重放日志，
+// 日志尾部被截断或损坏的记录会被丢弃。只支持可平凡复制的元素。
+template <typename ElementType>
+class DurableList {
+	static_assert(std::is_trivially_copyable_v<ElementType>, "journal records store elements as raw bytes");
+
+private:
+	enum class Op : uint8_t {
+		PushBack = 1,
+		PopFront = 2,
+		Insert = 3,
+		Clear = 4,
+	};
+
+	// 记录格式：op(1) | index(8) | value(sizeof) | fnv1a(4)
+	static constexpr std::size_t payload_bytes = 1 + sizeof(uint64_t) + sizeof(ElementType);
+	static constexpr std::size_t record_bytes = payload_bytes + sizeof(uint32_t);
+	static constexpr uint64_t checkpoint_magic = 0x314b434c5255444dULL; // "MDURLCK1"
+
+	static uint32_t checksum(const char* data, std::size_t bytes);
+
+	DoublyLinkedList<ElementType> _list;
+	std::filesystem::path _directory;
+	DurabilityOptions _options;
+	uint64_t _generation = 0;     // 当前日志文件的代数
+	uint64_t _log_records = 0;    // 当前日志文件中的记录数（含未提交的）
+	uint64_t _pending = 0;        // 缓冲区中未提交的记录数
+	uint64_t _syncs = 0;
+	uint64_t _committed_bytes = 0; // 日志文件中已提交部分的长度
+	bool _torn = false;           // 上次提交失败，文件末尾可能留有写了一半的批次
+	std::vector<char> _buffer;
+	int _log_fd = -1;
+
+	[[nodiscard]] std::filesystem::path log_path(uint64_t generation) const;
+	[[nodiscard]] std::filesystem::path checkpoint_path() const { return _directory / "checkpoint"; }
+
+	void recover();
+	void load_checkpoint();
+	void replay_log();
+	void open_log();
+	void apply(Op op, uint64_t index, const ElementType& val);
+	void append(Op op, uint64_t index, const ElementType& val);
+	void insert_at(uint64_t index, const ElementType& val);
+
+	static void write_all(int fd, const char* data, std::size_t bytes);
+	static void sync_directory(const std::filesystem::path& directory);
+	[[noreturn]] static void fail(const char* what) { throw std::system_error(errno, std::generic_category(), what); }
+
+public:
+	explicit DurableList(std::filesystem::path directory, DurabilityOptions options = {});
+
+	DurableList(const DurableList& ano_list) = delete;
+	DurableList& operator=(const DurableList& ano_list) = delete;
+
+	// 析构时提交剩余记录
+	~DurableList();
+
+public:
+	auto begin() const { return _list.begin(); }
+	auto end() const { return _list.end(); }
+	ElementType front() const { return _list.front(); }
+	ElementType back() const { return _list.back(); }
+	[[nodiscard]] uint64_t size() const { return _list.size(); }
+	[[nodiscard]] bool empty() const { return _list.empty(); }
+
+	void push_back(const ElementType& val);
+	void pop_front();
+	// 插到第 index 个元素之前，index == size() 时追加到末尾
+	void insert(uint64_t index, const ElementType& val);
+	void clear();
+
+	// 立即提交缓冲区中的记录；失败时记录留在缓冲区中，再次调用会先截掉写了一半的部分再重写
+	void sync();
+	// 写快照并切换到新一代日志，旧日志随后删除
+	void checkpoint();
+
+	[[nodiscard]] uint64_t pending_records() const { return _pending; }
+	[[nodiscard]] uint64_t log_records() const { return _log_records; }
+	[[nodiscard]] uint64_t sync_count() const { return _syncs; }
+	[[nodiscard]] uint64_t generation() const { return _generation; }
+};
+
+template <typename ElementType>
+DurableList<ElementType>::DurableList(std::filesystem::path directory, DurabilityOptions options) :
+	_directory{std::move(directory)}, _options{options} {
+	if (_options.sync_every == 0) {
+		_options.sync_every = 1;
+	}
+	std::filesystem::create_directories(_directory);
+	recover();
+}
+
+template <typename ElementType>
+DurableList<ElementType>::~DurableList() {
+	try {
+		sync();
+	} catch (...) {
+		// 析构中无法上报，未提交的记录按崩溃处理
+	}
+	if (_log_fd >= 0) {
+		::close(_log_fd);
+	}
+}
+
+template <typename ElementType>
+uint32_t DurableList<ElementType>::checksum(const char* data, std::size_t bytes) {
+	uint32_t hash = 2166136261u;
+	for (std::size_t i = 0; i < bytes; ++i) {
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+template <typename ElementType>
+std::filesystem::path DurableList<ElementType>::log_path(uint64_t generation) const {
+	return _directory / ("wal." + std::to_string(generation));
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::write_all(int fd, const char* data, std::size_t bytes) {
+	while (bytes > 0) {
+		const ssize_t written = ::write(fd, data, bytes);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			fail("Cannot write journal");
+		}
+		data += written;
+		bytes -= static_cast<std::size_t>(written);
+	}
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::sync_directory(const std::filesystem::path& directory) {
+	// rename 和新建文件只有在目录本身落盘后才算持久
+	const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+	if (fd < 0) {
+		fail("Cannot open journal directory");
+	}
+	::fsync(fd);
+	::close(fd);
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::recover() {
+	load_checkpoint();
+	replay_log();
+
+	// 快照之前的旧日志已经没有用处
+	for (const auto& entry : std::filesystem::directory_iterator(_directory)) {
+		const std::string name = entry.path().filename().string();
+		if (name.starts_with("wal.") && name != log_path(_generation).filename().string()) {
+			std::filesystem::remove(entry.path());
+		}
+	}
+	open_log();
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::load_checkpoint() {
+	const int fd = ::open(checkpoint_path().c_str(), O_RDONLY);
+	if (fd < 0) {
+		if (errno == ENOENT) {
+			return;
+		}
+		fail("Cannot open checkpoint");
+	}
+
+	// 快照格式：magic | 代数 | 元素个数 | 元素... | fnv1a；快照通过 rename 原子替换，不会出现半个文件
+	std::vector<char> data;
+	std::array<char, 1 << 16> chunk;
+	ssize_t got;
+	while ((got = ::read(fd, chunk.data(), chunk.size())) > 0) {
+		data.insert(data.end(), chunk.data(), chunk.data() + got);
+	}
+	::close(fd);
+
+	uint64_t header[3];
+	if (got < 0 || data.size() < sizeof(header) + sizeof(uint32_t)) {
+		throw std::runtime_error("Corrupted checkpoint.");
+	}
+	std::memcpy(header, data.data(), sizeof(header));
+	const uint64_t count = header[2];
+	const std::size_t body_bytes = sizeof(header) + count * sizeof(ElementType);
+	uint32_t stored;
+	if (header[0] != checkpoint_magic || data.size() != body_bytes + sizeof(stored)) {
+		throw std::runtime_error("Corrupted checkpoint.");
+	}
+	std::memcpy(&stored, data.data() + body_bytes, sizeof(stored));
+	if (stored != checksum(data.data(), body_bytes)) {
+		throw std::runtime_error("Corrupted checkpoint.");
+	}
+
+	_generation = header[1];
+	const char* cursor = data.data() + sizeof(header);
+	for (uint64_t i = 0; i < count; ++i, cursor += sizeof(ElementType)) {
+		ElementType val;
+		std::memcpy(&val, cursor, sizeof(ElementType));
+		_list.push_back(val);
+	}
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::replay_log() {
+	const int fd = ::open(log_path(_generation).c_str(), O_RDWR);
+	if (fd < 0) {
+		if (errno == ENOENT) {
+			return;
+		}
+		fail("Cannot open journal");
+	}
+
+	std::array<char, record_bytes> record;
+	uint64_t valid_bytes = 0;
+	while (true) {
+		std::size_t filled = 0;
+		while (filled < record_bytes) {
+			const ssize_t got = ::read(fd, record.data() + filled, record_bytes - filled);
+			if (got < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				// 读失败不等于日志到此结束，不能按写了一半的批次截断
+				const int error = errno;
+				::close(fd);
+				errno = error;
+				fail("Cannot read journal");
+			}
+			if (got == 0) {
+				break;
+			}
+			filled += static_cast<std::size_t>(got);
+		}
+
+		// 不完整或校验失败的记录来自崩溃时写了一半的批次，从这里截断
+		uint32_t stored;
+		std::memcpy(&stored, record.data() + payload_bytes, sizeof(stored));
+		if (filled < record_bytes || stored != checksum(record.data(), payload_bytes)) {
+			break;
+		}
+
+		uint64_t index;
+		ElementType val;
+		std::memcpy(&index, record.data() + 1, sizeof(index));
+		std::memcpy(&val, record.data() + 1 + sizeof(index), sizeof(ElementType));
+		apply(static_cast<Op>(record[0]), index, val);
+		valid_bytes += record_bytes;
+		++_log_records;
+	}
+
+	if (::ftruncate(fd, static_cast<off_t>(valid_bytes)) != 0) {
+		::close(fd);
+		fail("Cannot truncate journal");
+	}
+	::close(fd);
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::open_log() {
+	const bool created = !std::filesystem::exists(log_path(_generation));
+	_log_fd = ::open(log_path(_generation).c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+	if (_log_fd < 0) {
+		fail("Cannot open journal");
+	}
+	const off_t length = ::lseek(_log_fd, 0, SEEK_END);
+	if (length < 0) {
+		fail("Cannot open journal");
+	}
+	_committed_bytes = static_cast<uint64_t>(length);
+	if (created) {
+		sync_directory(_directory);
+	}
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::insert_at(uint64_t index, const ElementType& val) {
+	auto it = _list.begin();
+	for (uint64_t i = 0; i < index; ++i) {
+		++it;
+	}
+	_list.insert(it, val);
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::apply(Op op, uint64_t index, const ElementType& val) {
+	switch (op) {
+	case Op::PushBack:
+		_list.push_back(val);
+		break;
+	case Op::PopFront:
+		_list.pop_front();
+		break;
+	case Op::Insert:
+		insert_at(index, val);
+		break;
+	case Op::Clear:
+		_list.clear();
+		break;
+	default:
+		throw std::runtime_error("Unknown journal record.");
+	}
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::append(Op op, uint64_t index, const ElementType& val) {
+	const std::size_t offset = _buffer.size();
+	_buffer.resize(offset + record_bytes);
+	char* record = _buffer.data() + offset;
+	record[0] = static_cast<char>(op);
+	std::memcpy(record + 1, &index, sizeof(index));
+	std::memcpy(record + 1 + sizeof(index), &val, sizeof(ElementType));
+	const uint32_t sum = checksum(record, payload_bytes);
+	std::memcpy(record + payload_bytes, &sum, sizeof(sum));
+
+	++_pending;
+	++_log_records;
+	if (_pending >= _options.sync_every) {
+		sync();
+	}
+	if (_options.checkpoint_every && _log_records >= _options.checkpoint_every) {
+		checkpoint();
+	}
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::push_back(const ElementType& val) {
+	_list.push_back(val);
+	append(Op::PushBack, 0, val);
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::pop_front() {
+	_list.pop_front(); // 空链表时在写日志之前抛出
+	append(Op::PopFront, 0, ElementType{});
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::insert(uint64_t index, const ElementType& val) {
+	if (index > _list.size()) {
+		throw std::out_of_range("Insert position out of range.");
+	}
+	insert_at(index, val);
+	append(Op::Insert, index, val);
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::clear() {
+	_list.clear();
+	append(Op::Clear, 0, ElementType{});
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::sync() {
+	if (_pending == 0) {
+		return;
+	}
+	// 上次失败时可能已经写进去一部分，先截回到已提交的位置，重试不会让记录重复
+	if (_torn && ::ftruncate(_log_fd, static_cast<off_t>(_committed_bytes)) != 0) {
+		fail("Cannot truncate journal");
+	}
+	_torn = true;
+	write_all(_log_fd, _buffer.data(), _buffer.size());
+	if (::fdatasync(_log_fd) != 0) {
+		fail("Cannot sync journal");
+	}
+	_torn = false;
+	_committed_bytes += _buffer.size();
+	_buffer.clear();
+	_pending = 0;
+	++_syncs;
+}
+
+template <typename ElementType>
+void DurableList<ElementType>::checkpoint() {
+	sync();
+
+	// 先写临时文件并落盘，再原子地替换旧快照
+	uint64_t header[3] = {checkpoint_magic, _generation + 1, _list.size()};
+	std::vector<char> data(sizeof(header) + _list.size() * sizeof(ElementType));
+	std::memcpy(data.data(), header, sizeof(header));
+	char* cursor = data.data() + sizeof(header);
+	for (auto it = _list.begin(); it != _list.end(); ++it, cursor += sizeof(ElementType)) {
+		std::memcpy(cursor, &*it, sizeof(ElementType));
+	}
+	const uint32_t sum = checksum(data.data(), data.size());
+	data.insert(data.end(), reinterpret_cast<const char*>(&sum), reinterpret_cast<const char*>(&sum) + sizeof(sum));
+
+	const auto temp_path = _directory / "checkpoint.tmp";
+	const int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		fail("Cannot create checkpoint");
+	}
+	try {
+		write_all(fd, data.data(), data.size());
+		if (::fdatasync(fd) != 0) {
+			fail("Cannot sync checkpoint");
+		}
+	} catch (...) {
+		::close(fd);
+		throw;
+	}
+	::close(fd);
+	std::filesystem::rename(temp_path, checkpoint_path());
+	sync_directory(_directory);
+
+	// 快照指向新一代日志之后，旧日志即使残留也不会被重放
+	::close(_log_fd);
+	_log_fd = -1;
+	std::filesystem::remove(log_path(_generation));
+	++_generation;
+	_log_records = 0;
+	open_log();
+}
+}
+
+
+#endif //DURABLELIST_HPP
@@ -0,0 +1,273 @@
+#ifndef EPOCHRECLAMATION_HPP
+#define EPOCHRECLAMATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mystl {
+// 基于纪元的延迟回收。读者进入临界区时只写自己独占缓存行里的纪元记录；
+// 写者把摘下的对象交给 retire()，等所有活跃读者都越过两个纪元后再真正释放。
+// 读者记录由域和读者线程共同持有，域先于读者线程析构也是安全的。
+class EpochDomain {
+public:
+	EpochDomain() : _id{next_id()} {}
+
+	EpochDomain(const EpochDomain& ano_domain) = delete;
+	EpochDomain& operator=(const EpochDomain& ano_domain) = delete;
+
+	// 析构时不能再有活跃读者，剩余的退休对象全部立即释放
+	~EpochDomain();
+
+	static EpochDomain& global();
+
+	// 读者临界区的 RAII 守卫，可以嵌套
+	class Guard {
+	public:
+		explicit Guard(EpochDomain& domain) : _domain{&domain} { _domain->enter(); }
+
+		Guard(const Guard& ano_guard) = delete;
+		Guard& operator=(const Guard& ano_guard) = delete;
+
+		Guard(Guard&& ano_guard) noexcept : _domain{std::exchange(ano_guard._domain, nullptr)} {}
+		Guard& operator=(Guard&& ano_guard) = delete;
+
+		~Guard() {
+			if (_domain) {
+				_domain->exit();
+			}
+		}
+
+	private:
+		EpochDomain* _domain;
+	};
+
+public:
+	void enter();
+	void exit();
+	[[nodiscard]] Guard guard() { return Guard(*this); }
+
+	// 写者侧：登记一个已经对读者不可达的对象，满一批时顺便尝试回收
+	void retire(void* ptr, void (*deleter)(void*));
+	template <typename T>
+	void retire(T* ptr) {
+		retire(static_cast<void*>(ptr), [](void* p) { delete static_cast<T*>(p); });
+	}
+
+	// 推进纪元并释放所有已经安全的对象，不阻塞
+	void reclaim();
+	// 阻塞直到此前退休的对象全部释放；调用方自己不能处于读者临界区内
+	void synchronize();
+
+	[[nodiscard]] std::size_t pending() const;
+	[[nodiscard]] uint64_t epoch() const { return _global_epoch.load(std::memory_order_relaxed); }
+
+private:
+	// 每个读者线程独占一条缓存行
+	struct alignas(64) ReaderRecord {
+		std::atomic<uint64_t> _state{0}; // (纪元 << 1) | 活跃位，0 表示不在临界区
+		std::atomic<bool> _in_use{false};
+		std::atomic<bool> _domain_alive{true}; // 域析构时清除，线程缓存据此丢弃条目
+		ReaderRecord* _next = nullptr;
+		uint32_t _nesting = 0; // 只由所属线程访问
+	};
+
+	struct Retired {
+		void* _ptr;
+		void (*_deleter)(void*);
+		uint64_t _epoch;
+	};
+
+	static constexpr std::size_t reclaim_threshold = 64;
+
+	static uint64_t next_id() {
+		static std::atomic<uint64_t> counter{0};
+		return counter.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	ReaderRecord* local_record();
+	std::shared_ptr<ReaderRecord> acquire_record();
+	bool try_advance();
+	void free_safe(uint64_t current_epoch);
+
+	const uint64_t _id;
+	alignas(64) std::atomic<uint64_t> _global_epoch{1};
+	alignas(64) std::atomic<ReaderRecord*> _records{nullptr};
+	std::mutex _register_mutex;
+	std::vector<std::shared_ptr<ReaderRecord>> _owned_records;
+	mutable std::mutex _retire_mutex;
+	std::vector<Retired> _limbo;
+	std::size_t _next_reclaim_size = reclaim_threshold;
+};
+
+namespace epoch_detail {
+// 线程退出时把本线程占用的读者记录归还给各自的域，供之后的线程复用。
+// 最近使用的域单独缓存，同一个域上反复 enter/exit 不必扫描条目
+struct RecordCache {
+	struct Entry {
+		uint64_t _domain_id;
+		void* _record;
+		std::atomic<bool>* _in_use;
+		std::atomic<bool>* _domain_alive;
+		std::shared_ptr<void> _keep_alive;
+	};
+
+	std::vector<Entry> _entries;
+	uint64_t _last_domain_id = UINT64_MAX; // 域编号不重复使用，已析构的域不会再被命中
+	void* _last_record = nullptr;
+
+	~RecordCache() {
+		for (const auto& entry : _entries) {
+			entry._in_use->store(false, std::memory_order_release);
+		}
+	}
+};
+
+inline RecordCache& record_cache() {
+	static thread_local RecordCache cache;
+	return cache;
+}
+}
+
+inline EpochDomain::~EpochDomain() {
+	for (const auto& record : _owned_records) {
+		record->_domain_alive.store(false, std::memory_order_release);
+	}
+	for (const auto& retired : _limbo) {
+		retired._deleter(retired._ptr);
+	}
+}
+
+inline EpochDomain& EpochDomain::global() {
+	static auto* domain = new EpochDomain();
+	return *domain;
+}
+
+inline std::shared_ptr<EpochDomain::ReaderRecord> EpochDomain::acquire_record() {
+	std::lock_guard lock(_register_mutex);
+
+	// 先复用已退出线程留下的记录
+	for (const auto& record : _owned_records) {
+		bool expected = false;
+		if (record->_in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+			return record;
+		}
+	}
+
+	// 新记录挂到无锁链表头部，写者扫描时不需要加锁
+	auto record = std::make_shared<ReaderRecord>();
+	record->_in_use.store(true, std::memory_order_relaxed);
+	_owned_records.push_back(record);
+	ReaderRecord* head = _records.load(std::memory_order_relaxed);
+	do {
+		record->_next = head;
+	} while (!_records.compare_exchange_weak(head, record.get(), std::memory_order_release, std::memory_order_relaxed));
+	return record;
+}
+
+inline EpochDomain::ReaderRecord* EpochDomain::local_record() {
+	auto& cache = epoch_detail::record_cache();
+	if (cache._last_domain_id == _id) {
+		return static_cast<ReaderRecord*>(cache._last_record);
+	}
+	for (const auto& entry : cache._entries) {
+		if (entry._domain_id == _id) {
+			cache._last_domain_id = _id;
+			cache._last_record = entry._record;
+			return static_cast<ReaderRecord*>(entry._record);
+		}
+	}
+
+	// 未命中时顺便丢掉已析构的域留下的条目，条目数不超过本线程用过的存活域数
+	std::erase_if(cache._entries, [](const epoch_detail::RecordCache::Entry& entry) {
+		return !entry._domain_alive->load(std::memory_order_acquire);
+	});
+	auto record = acquire_record();
+	cache._entries.push_back({_id, record.get(), &record->_in_use, &record->_domain_alive, record});
+	cache._last_domain_id = _id;
+	cache._last_record = record.get();
+	return record.get();
+}
+
+inline void EpochDomain::enter() {
+	ReaderRecord* record = local_record();
+	if (record->_nesting++ == 0) {
+		record->_state.store((_global_epoch.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+		// 公布纪元之后才能读共享指针
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+}
+
+inline void EpochDomain::exit() {
+	ReaderRecord* record = local_record();
+	if (--record->_nesting == 0) {
+		record->_state.store(0, std::memory_order_release);
+	}
+}
+
+inline bool EpochDomain::try_advance() {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	uint64_t current = _global_epoch.load(std::memory_order_acquire);
+	for (ReaderRecord* record = _records.load(std::memory_order_acquire); record; record = record->_next) {
+		const uint64_t state = record->_state.load(std::memory_order_acquire);
+		if ((state & 1) && (state >> 1) != current) {
+			return false; // 还有读者停留在旧纪元
+		}
+	}
+	return _global_epoch.compare_exchange_strong(current, current + 1, std::memory_order_acq_rel);
+}
+
+inline void EpochDomain::free_safe(uint64_t current_epoch) {
+	// 在纪元 e 退休的对象，当全局纪元到达 e + 2 时已经没有读者能看到
+	std::size_t kept = 0;
+	for (auto& retired : _limbo) {
+		if (retired._epoch + 2 <= current_epoch) {
+			retired._deleter(retired._ptr);
+		} else {
+			_limbo[kept++] = retired;
+		}
+	}
+	_limbo.resize(kept);
+}
+
+inline void EpochDomain::retire(void* ptr, void (*deleter)(void*)) {
+	std::lock_guard lock(_retire_mutex);
+	_limbo.push_back(Retired{ptr, deleter, _global_epoch.load(std::memory_order_acquire)});
+	if (_limbo.size() >= _next_reclaim_size) {
+		try_advance();
+		free_safe(_global_epoch.load(std::memory_order_acquire));
+		// 读者迟迟不退出时放宽下一次尝试的门槛，避免每次 retire 都扫描整个待释放列表
+		_next_reclaim_size = std::max(reclaim_threshold, _limbo.size() * 2);
+	}
+}
+
+inline void EpochDomain::reclaim() {
+	std::lock_guard lock(_retire_mutex);
+	try_advance();
+	free_safe(_global_epoch.load(std::memory_order_acquire));
+}
+
+inline void EpochDomain::synchronize() {
+	while (true) {
+		reclaim();
+		if (pending() == 0) {
+			return;
+		}
+		std::this_thread::yield();
+	}
+}
+
+inline std::size_t EpochDomain::pending() const {
+	std::lock_guard lock(_retire_mutex);
+	return _limbo.size();
+}
+}
+
+
+#endif //EPOCHRECLAMATION_HPP
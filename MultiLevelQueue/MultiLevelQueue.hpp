@@ -0,0 +1,164 @@
+#ifndef MULTILEVELQUEUE_HPP
+#define MULTILEVELQUEUE_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+namespace mystl {
+// 多级队列，第 0 级优先级最高。每一级是一条 DoublyLinkedList，另用一个 64 位位图记录哪些级非空：
+// 第 l 级对应从最高位数起的第 l 位，std::countl_zero 一条指令就能找到优先级最高的非空级。
+// push、pop、按句柄在级之间移动或删除都是 O(1)，移动时节点经 extract 整体转挂，不重新分配也不复制元素。
+// 句柄与链表迭代器一样，在元素被 pop 或 erase 后失效
+template <typename ElementType, uint32_t Levels = 64, typename Allocator = std::allocator<ElementType>>
+class MultiLevelQueue {
+	static_assert(Levels > 0 && Levels <= 64, "non-empty levels are tracked in one 64-bit word");
+
+private:
+	using List = DoublyLinkedList<ElementType, Allocator>;
+
+	static constexpr uint64_t level_bit(uint32_t level) { return uint64_t{1} << (63 - level); }
+
+public:
+	// 指向队列中某个元素的句柄，记录元素当前所在的级
+	class Handle {
+	public:
+		Handle() = default;
+
+		[[nodiscard]] uint32_t level() const { return _level; }
+
+	private:
+		friend class MultiLevelQueue;
+
+		Handle(typename List::iterator it, uint32_t level) : _it{it}, _level{level} {}
+
+		typename List::iterator _it;
+		uint32_t _level = 0;
+	};
+
+	using handle_type = Handle;
+	using allocator_type = Allocator;
+
+private:
+	std::array<List, Levels> _levels;
+	uint64_t _bitmap = 0;
+	uint64_t _size = 0;
+
+	static void check_level(uint32_t level) {
+		if (level >= Levels) {
+			throw std::out_of_range("Priority level out of range.");
+		}
+	}
+
+	void mark(uint32_t level) { _bitmap |= level_bit(level); }
+	void unmark_if_empty(uint32_t level) {
+		if (_levels[level].empty()) {
+			_bitmap &= ~level_bit(level);
+		}
+	}
+
+public:
+	MultiLevelQueue() = default;
+
+public:
+	[[nodiscard]] uint64_t size() const { return _size; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+	[[nodiscard]] uint64_t size(uint32_t level) const { return _levels[level].size(); }
+	[[nodiscard]] static constexpr uint32_t levels() { return Levels; }
+
+	// 优先级最高的非空级，队列为空时返回 Levels
+	[[nodiscard]] uint32_t top_level() const {
+		return std::min(static_cast<uint32_t>(std::countl_zero(_bitmap)), Levels); // 位图为 0 时 countl_zero 返回 64
+	}
+	// 优先级最高的非空级的队首元素
+	ElementType top() const;
+	ElementType& value(const Handle& handle) const { return *typename List::iterator(handle._it); }
+
+	// 追加到第 level 级的队尾
+	Handle push(const ElementType& val, uint32_t level);
+	// 弹出优先级最高的非空级的队首元素
+	ElementType pop();
+
+	// 把元素移到第 level 级的队尾（移到同一级相当于重新排队），handle 随之更新
+	void move(Handle& handle, uint32_t level);
+	void erase(const Handle& handle);
+
+	void clear();
+};
+
+template <typename ElementType, uint32_t Levels, typename Allocator>
+ElementType MultiLevelQueue<ElementType, Levels, Allocator>::top() const {
+	if (empty()) {
+		throw std::out_of_range("Cannot access an empty queue.");
+	}
+	return _levels[top_level()].front();
+}
+
+template <typename ElementType, uint32_t Levels, typename Allocator>
+typename MultiLevelQueue<ElementType, Levels, Allocator>::Handle
+MultiLevelQueue<ElementType, Levels, Allocator>::push(const ElementType& val, uint32_t level) {
+	check_level(level);
+	List& list = _levels[level];
+	list.push_back(val);
+	mark(level);
+	++_size;
+
+	auto it = list.end();
+	--it;
+	return Handle(it, level);
+}
+
+template <typename ElementType, uint32_t Levels, typename Allocator>
+ElementType MultiLevelQueue<ElementType, Levels, Allocator>::pop() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty queue.");
+	}
+	const uint32_t level = top_level();
+	List& list = _levels[level];
+	auto node = list.extract(list.begin());
+	unmark_if_empty(level);
+	--_size;
+	return std::move(node.value());
+}
+
+template <typename ElementType, uint32_t Levels, typename Allocator>
+void MultiLevelQueue<ElementType, Levels, Allocator>::move(Handle& handle, uint32_t level) {
+	check_level(level);
+	List& from = _levels[handle._level];
+	List& to = _levels[level];
+
+	// 节点本身不变，只是从一条链表摘下再链入另一条
+	auto node = from.extract(handle._it);
+	unmark_if_empty(handle._level);
+	handle._it = to.insert(to.end(), std::move(node));
+	handle._level = level;
+	mark(level);
+}
+
+template <typename ElementType, uint32_t Levels, typename Allocator>
+void MultiLevelQueue<ElementType, Levels, Allocator>::erase(const Handle& handle) {
+	_levels[handle._level].erase(handle._it);
+	unmark_if_empty(handle._level);
+	--_size;
+}
+
+template <typename ElementType, uint32_t Levels, typename Allocator>
+void MultiLevelQueue<ElementType, Levels, Allocator>::clear() {
+	// 只清理非空的级
+	while (_bitmap) {
+		const uint32_t level = static_cast<uint32_t>(std::countl_zero(_bitmap));
+		_levels[level].clear();
+		_bitmap &= ~level_bit(level);
+	}
+	_size = 0;
+}
+}
+
+
+#endif //MULTILEVELQUEUE_HPP
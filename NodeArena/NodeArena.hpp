@@ -0,0 +1,319 @@
+#ifndef NODEARENA_HPP
+#define NODEARENA_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mystl {
+enum class HugePagePolicy {
+	None,        // 普通 4K 页
+	Transparent, // 普通映射后 madvise(MADV_HUGEPAGE)，交给内核合并成透明大页
+	Explicit,    // 先尝试 MAP_HUGETLB，系统没有预留大页时退化为 Transparent
+};
+
+struct ArenaOptions {
+	std::size_t chunk_bytes = std::size_t{2} << 20; // 每次向系统申请的块大小，默认一个 2M 大页
+	HugePagePolicy huge_pages = HugePagePolicy::Transparent;
+	int numa_node = -1; // 绑定到的 NUMA 节点，-1 表示不绑定
+};
+
+// 链表节点用的区域分配器：按块向系统申请内存，块内顺序切分，释放的小块按大小分类复用。
+// 大页和 NUMA 绑定都是尽力而为，失败时静默退化，可以通过 huge_pages_active()/numa_bound() 查询。
+// 与链表一样不是线程安全的。
+class NodeArena {
+public:
+	explicit NodeArena(ArenaOptions options = {}) : _options{options} {}
+
+	NodeArena(const NodeArena& ano_arena) = delete;
+	NodeArena& operator=(const NodeArena& ano_arena) = delete;
+
+	~NodeArena() { release_all(); }
+
+public:
+	void* allocate(std::size_t bytes, std::size_t alignment);
+	void deallocate(void* ptr, std::size_t bytes) noexcept;
+
+	// 一次性归还所有块，之前分配出去的内存全部失效
+	void release_all() noexcept;
+	// 保留已申请的块，只把游标和空闲链表回到初始状态，之前分配出去的内存全部失效。
+	// 反复填满再清空时不必每次都向系统归还、重新申请并触发缺页
+	void reset() noexcept;
+
+	[[nodiscard]] std::size_t bytes_reserved() const { return _bytes_reserved; }
+	// 已分配出去、尚未 deallocate 的块数
+	[[nodiscard]] std::size_t live_blocks() const { return _live_blocks; }
+	[[nodiscard]] std::size_t chunk_count() const { return _chunks.size(); }
+	// 是否有块申请到了大页（MAP_HUGETLB 成功或 madvise(MADV_HUGEPAGE) 被接受），不代表内核真的用大页映射
+	[[nodiscard]] bool huge_pages_requested() const { return _huge_pages_requested; }
+	// 是否确实有块由大页映射：读取 /proc/self/smaps 中各块的 AnonHugePages 与 KernelPageSize，
+	// 透明大页只在缺页或 khugepaged 合并后出现，应在写入之后查询。开销较大，不要在热路径上调用
+	[[nodiscard]] bool huge_pages_active() const;
+	[[nodiscard]] bool numa_bound() const { return _numa_bound; }
+	[[nodiscard]] const ArenaOptions& options() const { return _options; }
+
+private:
+	struct Chunk {
+		void* _base;
+		std::size_t _bytes;
+		bool _mapped;
+	};
+
+	struct FreeBlock {
+		FreeBlock* _next;
+	};
+
+	static constexpr std::size_t size_class_granularity = 16;
+	static constexpr std::size_t size_class_count = 16; // 最大复用 256 字节的块
+
+	static std::size_t size_class_of(std::size_t bytes) {
+		return (bytes + size_class_granularity - 1) / size_class_granularity;
+	}
+
+	void new_chunk(std::size_t min_bytes);
+	void* map_chunk(std::size_t bytes, bool& mapped);
+	void bind_chunk(void* base, std::size_t bytes);
+
+	ArenaOptions _options;
+	std::vector<Chunk> _chunks;
+	char* _cursor = nullptr;
+	char* _limit = nullptr;
+	std::array<FreeBlock*, size_class_count + 1> _free_lists{};
+	std::size_t _bytes_reserved = 0;
+	std::size_t _live_blocks = 0;
+	std::size_t _next_chunk = 0; // reset() 之后下一个可以复用的块，正常分配时等于 _chunks.size()
+	bool _huge_pages_requested = false;
+	bool _numa_bound = false;
+};
+
+inline void* NodeArena::allocate(std::size_t bytes, std::size_t alignment) {
+	const std::size_t size_class = size_class_of(bytes);
+	const bool reusable = size_class <= size_class_count && alignment <= size_class_granularity;
+
+	// 先从同尺寸的空闲链表取
+	if (reusable && _free_lists[size_class]) {
+		FreeBlock* block = _free_lists[size_class];
+		_free_lists[size_class] = block->_next;
+		++_live_blocks;
+		return block;
+	}
+
+	const std::size_t rounded = reusable ? size_class * size_class_granularity : bytes;
+	const std::size_t align = alignment < size_class_granularity ? size_class_granularity : alignment;
+
+	auto aligned_cursor = [&] {
+		const auto address = reinterpret_cast<std::uintptr_t>(_cursor);
+		return reinterpret_cast<char*>((address + align - 1) & ~(align - 1));
+	};
+
+	char* result = aligned_cursor();
+	if (!_cursor || result + rounded > _limit) {
+		new_chunk(rounded + align);
+		result = aligned_cursor();
+	}
+	_cursor = result + rounded;
+	++_live_blocks;
+	return result;
+}
+
+inline void NodeArena::deallocate(void* ptr, std::size_t bytes) noexcept {
+	--_live_blocks;
+	const std::size_t size_class = size_class_of(bytes);
+	if (size_class > size_class_count) {
+		return; // 大块不复用，随 release_all() 一起归还
+	}
+	auto block = static_cast<FreeBlock*>(ptr);
+	block->_next = _free_lists[size_class];
+	_free_lists[size_class] = block;
+}
+
+inline void NodeArena::release_all() noexcept {
+	for (const auto& chunk : _chunks) {
+#ifdef __linux__
+		if (chunk._mapped) {
+			munmap(chunk._base, chunk._bytes);
+			continue;
+		}
+#endif
+		::operator delete(chunk._base, std::align_val_t{size_class_granularity});
+	}
+	_chunks.clear();
+	_free_lists.fill(nullptr);
+	_cursor = nullptr;
+	_limit = nullptr;
+	_live_blocks = 0;
+	_bytes_reserved = 0;
+	_next_chunk = 0;
+}
+
+inline void NodeArena::reset() noexcept {
+	_free_lists.fill(nullptr);
+	_cursor = nullptr;
+	_limit = nullptr;
+	_live_blocks = 0;
+	_next_chunk = 0;
+}
+
+inline void NodeArena::new_chunk(std::size_t min_bytes) {
+	// reset() 之后先按顺序复用保留下来的块，放不下这次请求的块跳过，等下一次 reset() 再用
+	while (_next_chunk < _chunks.size()) {
+		const Chunk& chunk = _chunks[_next_chunk++];
+		if (chunk._bytes >= min_bytes) {
+			_cursor = static_cast<char*>(chunk._base);
+			_limit = _cursor + chunk._bytes;
+			return;
+		}
+	}
+
+	std::size_t bytes = _options.chunk_bytes;
+	while (bytes < min_bytes) {
+		bytes *= 2;
+	}
+
+	bool mapped = false;
+	void* base = map_chunk(bytes, mapped);
+	_chunks.push_back(Chunk{base, bytes, mapped});
+	_cursor = static_cast<char*>(base);
+	_limit = _cursor + bytes;
+	_bytes_reserved += bytes;
+	_next_chunk = _chunks.size();
+}
+
+inline bool NodeArena::huge_pages_active() const {
+#ifdef __linux__
+	if (!_huge_pages_requested) {
+		return false;
+	}
+	std::ifstream smaps("/proc/self/smaps");
+	std::string line;
+	bool in_chunk = false;
+	while (std::getline(smaps, line)) {
+		// 映射区间的首行形如 "7f0000000000-7f0000200000 rw-p ..."，其余行是 "字段: 数值 kB"
+		unsigned long long begin = 0;
+		unsigned long long end = 0;
+		if (std::sscanf(line.c_str(), "%llx-%llx ", &begin, &end) == 2) {
+			in_chunk = std::any_of(_chunks.begin(), _chunks.end(), [begin, end](const Chunk& chunk) {
+				const auto base = reinterpret_cast<std::uintptr_t>(chunk._base);
+				return chunk._mapped && base < end && base + chunk._bytes > begin;
+			});
+			continue;
+		}
+		if (!in_chunk) {
+			continue;
+		}
+		unsigned long long kilobytes = 0;
+		if ((std::sscanf(line.c_str(), "AnonHugePages: %llu kB", &kilobytes) == 1 && kilobytes > 0) ||
+		    (std::sscanf(line.c_str(), "KernelPageSize: %llu kB", &kilobytes) == 1 && kilobytes > 4)) {
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
+inline void* NodeArena::map_chunk(std::size_t bytes, bool& mapped) {
+#ifdef __linux__
+	void* base = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+	if (_options.huge_pages == HugePagePolicy::Explicit) {
+		// 需要系统预留 hugetlbfs 大页，失败很常见
+		base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (base != MAP_FAILED) {
+			_huge_pages_requested = true;
+		}
+	}
+#endif
+
+	if (base == MAP_FAILED) {
+		base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+		if (base != MAP_FAILED && _options.huge_pages != HugePagePolicy::None) {
+			if (madvise(base, bytes, MADV_HUGEPAGE) == 0) {
+				_huge_pages_requested = true;
+			}
+		}
+#endif
+	}
+
+	if (base != MAP_FAILED) {
+		// 绑定必须在第一次写入（缺页）之前完成
+		bind_chunk(base, bytes);
+		mapped = true;
+		return base;
+	}
+#endif
+
+	mapped = false;
+	return ::operator new(bytes, std::align_val_t{size_class_granularity});
+}
+
+inline void NodeArena::bind_chunk(void* base, std::size_t bytes) {
+#if defined(__linux__) && defined(SYS_mbind)
+	if (_options.numa_node < 0) {
+		return;
+	}
+	constexpr std::size_t mask_bits = sizeof(unsigned long) * 8;
+	const auto node = static_cast<std::size_t>(_options.numa_node);
+	std::vector<unsigned long> mask(node / mask_bits + 1, 0);
+	mask[node / mask_bits] |= 1UL << (node % mask_bits);
+
+	// 直接走系统调用，不依赖 libnuma；内核不支持 NUMA 时返回错误，保持默认策略
+	if (syscall(SYS_mbind, base, bytes, MPOL_BIND, mask.data(), mask.size() * mask_bits + 1, 0) == 0) {
+		_numa_bound = true;
+	}
+#else
+	(void)base;
+	(void)bytes;
+#endif
+}
+
+// 把 NodeArena 包装成标准分配器，供 DoublyLinkedList 的 Allocator 参数使用
+template <typename T>
+class ArenaAllocator {
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	explicit ArenaAllocator(NodeArena& arena) noexcept : _arena{&arena} {}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& ano_alloc) noexcept : _arena{ano_alloc.arena()} {}
+
+	T* allocate(std::size_t n) { return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T))); }
+	void deallocate(T* ptr, std::size_t n) noexcept { _arena->deallocate(ptr, n * sizeof(T)); }
+
+	[[nodiscard]] NodeArena* arena() const noexcept { return _arena; }
+
+	// 供 DoublyLinkedList::clear 整体释放：区域里只剩它自己的节点时直接重置区域，块留给之后的节点
+	[[nodiscard]] std::size_t live_blocks() const noexcept { return _arena->live_blocks(); }
+	void reset() noexcept { _arena->reset(); }
+	void release_all() noexcept { _arena->release_all(); }
+
+	template <typename U>
+	bool operator==(const ArenaAllocator<U>& ano_alloc) const noexcept { return _arena == ano_alloc.arena(); }
+
+private:
+	NodeArena* _arena;
+};
+}
+
+
+#endif //NODEARENA_HPP
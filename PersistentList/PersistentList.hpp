@@ -0,0 +1,343 @@
+#ifndef PERSISTENTLIST_HPP
+#define PERSISTENTLIST_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+namespace mystl {
+// 持久化序列：以隐式下标为键的 AVL 树，所有节点不可变，修改时只复制根到目标的一条路径。
+// 拷贝和 snapshot() 只复制根指针，因此是 O(1)；快照之间共享未被修改的子树。
+template <typename ElementType>
+struct PersistentList {
+private:
+	struct TreeNode;
+	using NodePtr = std::shared_ptr<const TreeNode>;
+
+	struct TreeNode {
+		NodePtr _left;
+		NodePtr _right;
+		ElementType _val;
+		uint64_t _size;
+		int32_t _height;
+
+		TreeNode(NodePtr left, ElementType val, NodePtr right);
+	};
+
+	// 中序遍历迭代器，用显式栈保存从根到当前节点的左链
+	class Iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const ElementType*;
+		using reference = const ElementType&;
+
+		std::vector<const TreeNode*> _stack;
+
+	public:
+		Iterator() = default;
+		explicit Iterator(const TreeNode* root) { push_left(root); }
+
+	public:
+		const ElementType& operator*() const { return _stack.back()->_val; }
+		const ElementType* operator->() const { return &_stack.back()->_val; }
+
+		Iterator& operator++();
+		Iterator operator++(int);
+
+		bool operator!=(const Iterator& ano_iter) const { return _stack != ano_iter._stack; }
+		bool operator==(const Iterator& ano_iter) const { return _stack == ano_iter._stack; }
+
+	private:
+		void push_left(const TreeNode* node);
+	};
+
+private:
+	NodePtr _root;
+
+	static uint64_t size_of(const NodePtr& node) { return node ? node->_size : 0; }
+	static int32_t height_of(const NodePtr& node) { return node ? node->_height : 0; }
+
+	static NodePtr make(NodePtr left, ElementType val, NodePtr right);
+	static NodePtr balance(NodePtr left, ElementType val, NodePtr right);
+	static NodePtr insert_at(const NodePtr& node, uint64_t index, const ElementType& val);
+	static NodePtr erase_at(const NodePtr& node, uint64_t index);
+	static NodePtr assign_at(const NodePtr& node, uint64_t index, const ElementType& val);
+	static std::pair<NodePtr, ElementType> remove_min(const NodePtr& node);
+	template <typename InputIt>
+	static NodePtr build(uint64_t count, InputIt& it);
+
+public:
+	PersistentList() = default;
+	PersistentList(std::initializer_list<ElementType> list);
+	template <typename Allocator, typename StatsPolicy>
+	explicit PersistentList(const DoublyLinkedList<ElementType, Allocator, StatsPolicy>& ano_list);
+
+	PersistentList(const PersistentList& ano_list) = default;
+	PersistentList& operator=(const PersistentList& ano_list) = default;
+
+	PersistentList(PersistentList&& ano_list) noexcept = default;
+	PersistentList& operator=(PersistentList&& ano_list) noexcept = default;
+
+	~PersistentList() = default;
+
+	template <typename Allocator, typename StatsPolicy>
+	explicit operator DoublyLinkedList<ElementType, Allocator, StatsPolicy>() const;
+
+public:
+	// 返回当前版本的只读快照，之后对本对象的修改不会影响快照
+	[[nodiscard]] PersistentList snapshot() const { return *this; }
+
+	Iterator begin() const { return Iterator(_root.get()); }
+	Iterator end() const { return Iterator(); }
+	const ElementType& front() const { return at(0); }
+	const ElementType& back() const { return at(size() - 1); }
+	const ElementType& at(uint64_t index) const;
+	const ElementType& operator[](uint64_t index) const { return at(index); }
+	[[nodiscard]] uint64_t size() const { return size_of(_root); }
+	[[nodiscard]] bool empty() const { return _root == nullptr; }
+
+	void push_front(const ElementType& val) { _root = insert_at(_root, 0, val); }
+	void push_back(const ElementType& val) { _root = insert_at(_root, size(), val); }
+	void insert(uint64_t index, const ElementType& val);
+	void set(uint64_t index, const ElementType& val);
+
+	void pop_back();
+	void pop_front();
+	void erase(uint64_t index);
+
+	void clear() { _root.reset(); }
+};
+
+template <typename ElementType>
+PersistentList<ElementType>::TreeNode::TreeNode(NodePtr left, ElementType val, NodePtr right) :
+	_left{std::move(left)}, _right{std::move(right)}, _val{std::move(val)},
+	_size{size_of(_left) + size_of(_right) + 1},
+	_height{std::max(height_of(_left), height_of(_right)) + 1} {}
+
+template <typename ElementType>
+typename PersistentList<ElementType>::Iterator& PersistentList<ElementType>::Iterator::operator++() {
+	const TreeNode* current = _stack.back();
+	_stack.pop_back();
+	push_left(current->_right.get());
+	return *this;
+}
+
+template <typename ElementType>
+typename PersistentList<ElementType>::Iterator PersistentList<ElementType>::Iterator::operator++(int) {
+	Iterator old = *this;
+	++*this;
+	return old;
+}
+
+template <typename ElementType>
+void PersistentList<ElementType>::Iterator::push_left(const TreeNode* node) {
+	while (node) {
+		_stack.push_back(node);
+		node = node->_left.get();
+	}
+}
+
+template <typename ElementType>
+typename PersistentList<ElementType>::NodePtr
+PersistentList<ElementType>::make(NodePtr left, ElementType val, NodePtr right) {
+	return std::make_shared<const TreeNode>(std::move(left), std::move(val), std::move(right));
+}
+
+template <typename ElementType>
+typename PersistentList<ElementType>::NodePtr
+PersistentList<ElementType>::balance(NodePtr left, ElementType val, NodePtr right) {
+	const int32_t left_height = height_of(left);
+	const int32_t right_height = height_of(right);
+
+	if (left_height > right_height + 1) {
+		// 左高：单右旋或先左后右双旋，旋转中涉及的节点都重新生成
+		if (height_of(left->_left) >= height_of(left->_right)) {
+			return make(left->_left, left->_val, make(left->_right, std::move(val), std::move(right)));
+		}
+		const auto& pivot = left->_right;
+		return make(make(left->_left, left->_val, pivot->_left), pivot->_val,
+		            make(pivot->_right, std::move(val), std::move(right)));
+	}
+
+	if (right_height > left_height + 1) {
+		// 右高：与上面对称
+		if (height_of(right->_right) >= height_of(right->_left)) {
+			return make(make(std::move(left), std::move(val), right->_left), right->_val, right->_right);
+		}
+		const auto& pivot = right->_left;
+		return make(make(std::move(left), std::move(val), pivot->_left), pivot->_val,
+		            make(pivot->_right, right->_val, right->_right));
+	}
+
+	return make(std::move(left), std::move(val), std::move(right));
+}
+
+template <typename ElementType>
+typename PersistentList<ElementType>::NodePtr
+PersistentList<ElementType>::insert_at(const NodePtr& node, uint64_t index, const ElementType& val) {
+	if (!node) {
+		return make(nullptr, val, nullptr);
+	}
+
+	const uint64_t left_size = size_of(node->_left);
+	if (index <= left_size) {
+		return balance(insert_at(node->_left, index, val), node->_val, node->_right);
+	}
+	return balance(node->_left, node->_val, insert_at(node->_right, index - left_size - 1, val));
+}
+
+template <typename ElementType>
+typename PersistentList<ElementType>::NodePtr
+PersistentList<ElementType>::erase_at(const NodePtr& node, uint64_t index) {
+	const uint64_t left_size = size_of(node->_left);
+	if (index < left_size) {
+		return balance(erase_at(node->_left, index), node->_val, node->_right);
+	}
+	if (index > left_size) {
+		return balance(node->_left, node->_val, erase_at(node->_right, index - left_size - 1));
+	}
+
+	// 删除当前节点：用右子树的最小元素顶替
+	if (!node->_left) {
+		return node->_right;
+	}
+	if (!node->_right) {
+		return node->_left;
+	}
+	auto [rest, successor] = remove_min(node->_right);
+	return balance(node->_left, std::move(successor), std::move(rest));
+}
+
+template <typename ElementType>
+typename PersistentList<ElementType>::NodePtr
+PersistentList<ElementType>::assign_at(const NodePtr& node, uint64_t index, const ElementType& val) {
+	const uint64_t left_size = size_of(node->_left);
+	if (index < left_size) {
+		return make(assign_at(node->_left, index, val), node->_val, node->_right);
+	}
+	if (index > left_size) {
+		return make(node->_left, node->_val, assign_at(node->_right, index - left_size - 1, val));
+	}
+	return make(node->_left, val, node->_right);
+}
+
+template <typename ElementType>
+std::pair<typename PersistentList<ElementType>::NodePtr, ElementType>
+PersistentList<ElementType>::remove_min(const NodePtr& node) {
+	if (!node->_left) {
+		return {node->_right, node->_val};
+	}
+	auto [rest, min_val] = remove_min(node->_left);
+	return {balance(std::move(rest), node->_val, node->_right), std::move(min_val)};
+}
+
+template <typename ElementType>
+template <typename InputIt>
+typename PersistentList<ElementType>::NodePtr PersistentList<ElementType>::build(uint64_t count, InputIt& it) {
+	// 按中序一次性建成完全平衡的树，O(n)
+	if (count == 0) {
+		return nullptr;
+	}
+	const uint64_t left_count = count / 2;
+	auto left = build(left_count, it);
+	ElementType val = *it;
+	++it;
+	auto right = build(count - left_count - 1, it);
+	return make(std::move(left), std::move(val), std::move(right));
+}
+
+template <typename ElementType>
+PersistentList<ElementType>::PersistentList(std::initializer_list<ElementType> list) {
+	auto it = list.begin();
+	_root = build(list.size(), it);
+}
+
+template <typename ElementType>
+template <typename Allocator, typename StatsPolicy>
+PersistentList<ElementType>::PersistentList(const DoublyLinkedList<ElementType, Allocator, StatsPolicy>& ano_list) {
+	auto it = ano_list.begin();
+	_root = build(ano_list.size(), it);
+}
+
+template <typename ElementType>
+template <typename Allocator, typename StatsPolicy>
+PersistentList<ElementType>::operator DoublyLinkedList<ElementType, Allocator, StatsPolicy>() const {
+	DoublyLinkedList<ElementType, Allocator, StatsPolicy> result;
+	for (auto it = begin(); it != end(); ++it) {
+		result.push_back(*it);
+	}
+	return result;
+}
+
+template <typename ElementType>
+const ElementType& PersistentList<ElementType>::at(uint64_t index) const {
+	if (index >= size()) {
+		throw std::out_of_range("PersistentList index out of range.");
+	}
+
+	const TreeNode* node = _root.get();
+	while (true) {
+		const uint64_t left_size = size_of(node->_left);
+		if (index < left_size) {
+			node = node->_left.get();
+		} else if (index > left_size) {
+			index -= left_size + 1;
+			node = node->_right.get();
+		} else {
+			return node->_val;
+		}
+	}
+}
+
+template <typename ElementType>
+void PersistentList<ElementType>::insert(uint64_t index, const ElementType& val) {
+	if (index > size()) {
+		throw std::out_of_range("PersistentList index out of range.");
+	}
+	_root = insert_at(_root, index, val);
+}
+
+template <typename ElementType>
+void PersistentList<ElementType>::set(uint64_t index, const ElementType& val) {
+	if (index >= size()) {
+		throw std::out_of_range("PersistentList index out of range.");
+	}
+	_root = assign_at(_root, index, val);
+}
+
+template <typename ElementType>
+void PersistentList<ElementType>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	_root = erase_at(_root, size() - 1);
+}
+
+template <typename ElementType>
+void PersistentList<ElementType>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	_root = erase_at(_root, 0);
+}
+
+template <typename ElementType>
+void PersistentList<ElementType>::erase(uint64_t index) {
+	if (index >= size()) {
+		throw std::out_of_range("PersistentList index out of range.");
+	}
+	_root = erase_at(_root, index);
+}
+}
+
+
+#endif //PERSISTENTLIST_HPP
@@ -0,0 +1,199 @@
+#ifndef RCULIST_HPP
+#define RCULIST_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "../EpochReclamation/EpochReclamation.hpp"
+
+namespace mystl {
+// 单写者、多读者的双向链表。读者只做正向遍历，全程无锁，也不写任何共享缓存行；
+// 写者按 RCU 的方式先发布新链接、再把摘下的节点交给纪元域延迟释放。
+// 写者侧的所有操作必须由同一个线程（或在外部互斥下）执行。
+template <typename ElementType>
+struct RcuList {
+private:
+	struct RcuNodeBase {
+		std::atomic<RcuNodeBase*> _next{nullptr};
+		RcuNodeBase* _prev = nullptr; // 只有写者使用
+	};
+
+	struct RcuNode : RcuNodeBase {
+		const ElementType _val;
+
+		explicit RcuNode(const ElementType& val) : _val{val} {}
+	};
+
+	using NodeBase = RcuNodeBase;
+	using Node = RcuNode;
+
+	class Iterator {
+	public:
+		NodeBase* _current = nullptr;
+
+	public:
+		Iterator() = default;
+		explicit Iterator(NodeBase* pt) : _current{pt} {}
+
+	public:
+		const ElementType& operator*() const { return static_cast<Node*>(_current)->_val; }
+		const ElementType* operator->() const { return &static_cast<Node*>(_current)->_val; }
+
+		Iterator& operator++() {
+			_current = _current->_next.load(std::memory_order_acquire);
+			return *this;
+		}
+
+		bool operator!=(const Iterator& ano_iter) const { return _current != ano_iter._current; }
+		bool operator==(const Iterator& ano_iter) const { return _current == ano_iter._current; }
+	};
+
+	// 读者视图：持有纪元守卫，存在期间遍历到的节点都不会被释放
+	class ReadView {
+	public:
+		explicit ReadView(const RcuList& list) : _guard{*list._domain}, _list{&list} {}
+
+		Iterator begin() const { return _list->begin(); }
+		Iterator end() const { return _list->end(); }
+
+	private:
+		EpochDomain::Guard _guard;
+		const RcuList* _list;
+	};
+
+public:
+	using iterator = Iterator;
+
+private:
+	NodeBase _sentinel;
+	std::atomic<uint64_t> _size{0};
+	EpochDomain* _domain;
+
+	NodeBase* sentinel() const { return const_cast<NodeBase*>(&_sentinel); }
+	void link_before(NodeBase* pos, const ElementType& val);
+	void unlink(NodeBase* node);
+
+public:
+	explicit RcuList(EpochDomain& domain = EpochDomain::global());
+
+	// 读者可能持有指向哨兵的指针，因此不可拷贝也不可移动
+	RcuList(const RcuList& ano_list) = delete;
+	RcuList& operator=(const RcuList& ano_list) = delete;
+
+	// 析构时不能再有读者
+	~RcuList();
+
+public:
+	// 读者侧
+	[[nodiscard]] ReadView read() const { return ReadView(*this); }
+	template <typename Function>
+	void for_each(Function function) const;
+	[[nodiscard]] uint64_t size() const { return _size.load(std::memory_order_relaxed); }
+	[[nodiscard]] bool empty() const { return size() == 0; }
+
+	// 写者侧；begin()/end() 在读者视图之外只能由写者使用
+	Iterator begin() const { return Iterator(_sentinel._next.load(std::memory_order_acquire)); }
+	Iterator end() const { return Iterator(sentinel()); }
+	const ElementType& front() const { return *begin(); }
+	const ElementType& back() const { return static_cast<Node*>(_sentinel._prev)->_val; }
+
+	void push_front(const ElementType& val) { link_before(_sentinel._next.load(std::memory_order_relaxed), val); }
+	void push_back(const ElementType& val) { link_before(sentinel(), val); }
+	void insert(Iterator it, const ElementType& val) { link_before(it._current, val); }
+
+	void pop_back();
+	void pop_front();
+	Iterator erase(Iterator it);
+
+	void clear();
+
+	EpochDomain& domain() const { return *_domain; }
+};
+
+template <typename ElementType>
+RcuList<ElementType>::RcuList(EpochDomain& domain) : _domain{&domain} {
+	_sentinel._next.store(&_sentinel, std::memory_order_relaxed);
+	_sentinel._prev = &_sentinel;
+}
+
+template <typename ElementType>
+RcuList<ElementType>::~RcuList() {
+	NodeBase* current = _sentinel._next.load(std::memory_order_relaxed);
+	while (current != &_sentinel) {
+		NodeBase* next_node = current->_next.load(std::memory_order_relaxed);
+		delete static_cast<Node*>(current);
+		current = next_node;
+	}
+}
+
+template <typename ElementType>
+template <typename Function>
+void RcuList<ElementType>::for_each(Function function) const {
+	EpochDomain::Guard guard(*_domain);
+	for (auto it = begin(); it != end(); ++it) {
+		function(*it);
+	}
+}
+
+template <typename ElementType>
+void RcuList<ElementType>::link_before(NodeBase* pos, const ElementType& val) {
+	auto new_node = new Node(val);
+	NodeBase* prev_node = pos->_prev;
+
+	// 新节点的链接先写好，再用 release 发布，读者看到新节点时它已经完整
+	new_node->_next.store(pos, std::memory_order_relaxed);
+	new_node->_prev = prev_node;
+	prev_node->_next.store(new_node, std::memory_order_release);
+	pos->_prev = new_node;
+
+	_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename ElementType>
+void RcuList<ElementType>::unlink(NodeBase* node) {
+	NodeBase* prev_node = node->_prev;
+	NodeBase* next_node = node->_next.load(std::memory_order_relaxed);
+
+	// 只让前驱跳过被删节点；被删节点自己的 _next 保持不变，正停在它上面的读者仍能继续向后走
+	prev_node->_next.store(next_node, std::memory_order_release);
+	next_node->_prev = prev_node;
+
+	_size.fetch_sub(1, std::memory_order_relaxed);
+	_domain->retire(static_cast<Node*>(node));
+}
+
+template <typename ElementType>
+void RcuList<ElementType>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	unlink(_sentinel._prev);
+}
+
+template <typename ElementType>
+void RcuList<ElementType>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	unlink(_sentinel._next.load(std::memory_order_relaxed));
+}
+
+template <typename ElementType>
+typename RcuList<ElementType>::Iterator RcuList<ElementType>::erase(Iterator it) {
+	NodeBase* next_node = it._current->_next.load(std::memory_order_relaxed);
+	unlink(it._current);
+	return Iterator(next_node);
+}
+
+template <typename ElementType>
+void RcuList<ElementType>::clear() {
+	while (!empty()) {
+		pop_front();
+	}
+}
+}
+
+
+#endif //RCULIST_HPP
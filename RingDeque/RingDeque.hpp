@@ -0,0 +1,336 @@
+#ifndef RINGDEQUE_HPP
+#define RINGDEQUE_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace mystl {
+enum class OverflowPolicy {
+	Grow,      // 容量翻倍
+	Overwrite, // 覆盖另一端最旧的元素
+	Fail,      // 拒绝写入，push 返回 false
+};
+
+// 以 2 的幂为容量的环形缓冲区，接口与 DoublyLinkedList 的队列部分一致，但不为每个元素分配节点。
+// 下标用位与取模；元素在缓冲区中连续存放，适合有界的 FIFO/LIFO 队列。
+template <typename ElementType, OverflowPolicy Policy = OverflowPolicy::Grow, typename Allocator = std::allocator<ElementType>>
+struct RingDeque {
+private:
+	using AllocTraits = std::allocator_traits<Allocator>;
+
+	static constexpr uint64_t initial_capacity = 16;
+
+	class Iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = ElementType*;
+		using reference = ElementType&;
+
+		const RingDeque* _deque = nullptr;
+		uint64_t _index = 0; // 相对队首的逻辑下标
+
+	public:
+		Iterator() = default;
+		Iterator(const RingDeque* deque, uint64_t index) : _deque{deque}, _index{index} {}
+
+	public:
+		ElementType& operator*() const { return _deque->slot(_index); }
+		ElementType* operator->() const { return &_deque->slot(_index); }
+
+		Iterator& operator++() {
+			++_index;
+			return *this;
+		}
+
+		Iterator& operator--() {
+			--_index;
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator old = *this;
+			++_index;
+			return old;
+		}
+
+		Iterator operator--(int) {
+			Iterator old = *this;
+			--_index;
+			return old;
+		}
+
+		bool operator!=(const Iterator& ano_iter) const { return _index != ano_iter._index; }
+		bool operator==(const Iterator& ano_iter) const { return _index == ano_iter._index; }
+	};
+
+public:
+	using iterator = Iterator;
+	using allocator_type = Allocator;
+
+	static constexpr OverflowPolicy overflow_policy = Policy;
+
+private:
+	ElementType* _buffer = nullptr;
+	uint64_t _capacity = 0; // 总是 0 或 2 的幂
+	uint64_t _head = 0;     // 队首在缓冲区中的位置
+	uint64_t _size = 0;
+	[[no_unique_address]] Allocator _alloc;
+
+	ElementType& slot(uint64_t index) const { return _buffer[(_head + index) & (_capacity - 1)]; }
+	void reallocate(uint64_t capacity);
+	void release() noexcept;
+	bool make_room();
+	template <typename Arg>
+	void construct_front(Arg&& arg);
+
+public:
+	RingDeque() noexcept = default;
+	// 容量向上取整到 2 的幂；Overwrite 与 Fail 策略下容量就是上限
+	explicit RingDeque(uint64_t capacity, const Allocator& alloc = Allocator());
+	RingDeque(std::initializer_list<ElementType> list);
+
+	RingDeque(const RingDeque& ano_deque);
+	RingDeque& operator=(const RingDeque& ano_deque);
+
+	RingDeque(RingDeque&& ano_deque) noexcept;
+	RingDeque& operator=(RingDeque&& ano_deque) noexcept;
+
+	~RingDeque() { release(); }
+
+public:
+	Iterator begin() const { return Iterator(this, 0); }
+	Iterator end() const { return Iterator(this, _size); }
+	ElementType& front() const { return slot(0); }
+	ElementType& back() const { return slot(_size - 1); }
+	ElementType& operator[](uint64_t index) const { return slot(index); }
+	[[nodiscard]] uint64_t size() const { return _size; }
+	[[nodiscard]] uint64_t capacity() const { return _capacity; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+	[[nodiscard]] bool full() const { return _size == _capacity; }
+
+	// 只有 Fail 策略且已满时返回 false
+	bool push_front(const ElementType& val);
+	bool push_back(const ElementType& val);
+
+	void pop_back();
+	void pop_front();
+
+	void clear();
+	// 预留至少 capacity 个元素的空间，不会缩小
+	void reserve(uint64_t capacity);
+
+	[[nodiscard]] allocator_type get_allocator() const { return _alloc; }
+};
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+RingDeque<ElementType, Policy, Allocator>::RingDeque(uint64_t capacity, const Allocator& alloc) : _alloc{alloc} {
+	reserve(capacity);
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+RingDeque<ElementType, Policy, Allocator>::RingDeque(std::initializer_list<ElementType> list) : RingDeque(list.size()) {
+	for (const auto& val : list) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+RingDeque<ElementType, Policy, Allocator>::RingDeque(const RingDeque& ano_deque) :
+	_alloc{AllocTraits::select_on_container_copy_construction(ano_deque._alloc)} {
+	reserve(ano_deque._capacity);
+	for (const auto& val : ano_deque) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+RingDeque<ElementType, Policy, Allocator>& RingDeque<ElementType, Policy, Allocator>::operator=(const RingDeque& ano_deque) {
+	if (this != &ano_deque) {
+		release();
+		if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+			_alloc = ano_deque._alloc;
+		}
+		reserve(ano_deque._capacity);
+		for (const auto& val : ano_deque) {
+			push_back(val);
+		}
+	}
+	return *this;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+RingDeque<ElementType, Policy, Allocator>::RingDeque(RingDeque&& ano_deque) noexcept :
+	_buffer{std::exchange(ano_deque._buffer, nullptr)},
+	_capacity{std::exchange(ano_deque._capacity, 0)},
+	_head{std::exchange(ano_deque._head, 0)},
+	_size{std::exchange(ano_deque._size, 0)},
+	_alloc{std::move(ano_deque._alloc)} {}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+RingDeque<ElementType, Policy, Allocator>& RingDeque<ElementType, Policy, Allocator>::operator=(RingDeque&& ano_deque) noexcept {
+	if (this != &ano_deque) {
+		release();
+		if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+			_alloc = std::move(ano_deque._alloc);
+		}
+		_buffer = std::exchange(ano_deque._buffer, nullptr);
+		_capacity = std::exchange(ano_deque._capacity, 0);
+		_head = std::exchange(ano_deque._head, 0);
+		_size = std::exchange(ano_deque._size, 0);
+	}
+	return *this;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+void RingDeque<ElementType, Policy, Allocator>::reallocate(uint64_t capacity) {
+	ElementType* buffer = AllocTraits::allocate(_alloc, capacity);
+
+	// 搬到新缓冲区时顺便把环展开，队首落在下标 0
+	uint64_t moved = 0;
+	try {
+		for (; moved < _size; ++moved) {
+			AllocTraits::construct(_alloc, buffer + moved, std::move_if_noexcept(slot(moved)));
+		}
+	} catch (...) {
+		for (uint64_t i = 0; i < moved; ++i) {
+			AllocTraits::destroy(_alloc, buffer + i);
+		}
+		AllocTraits::deallocate(_alloc, buffer, capacity);
+		throw;
+	}
+
+	const uint64_t size = _size;
+	release();
+	_buffer = buffer;
+	_capacity = capacity;
+	_size = size;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+void RingDeque<ElementType, Policy, Allocator>::release() noexcept {
+	clear();
+	if (_buffer) {
+		AllocTraits::deallocate(_alloc, _buffer, _capacity);
+		_buffer = nullptr;
+	}
+	_capacity = 0;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+void RingDeque<ElementType, Policy, Allocator>::reserve(uint64_t capacity) {
+	if (capacity > _capacity) {
+		reallocate(std::bit_ceil(capacity));
+	}
+}
+
+// 缓冲区已满时按策略腾出一个位置；返回 false 表示应当拒绝写入
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+bool RingDeque<ElementType, Policy, Allocator>::make_room() {
+	if constexpr (Policy == OverflowPolicy::Grow) {
+		reallocate(_capacity ? _capacity * 2 : initial_capacity);
+		return true;
+	} else {
+		return false;
+	}
+}
+
+// 在队首之前构造一个元素，调用方保证缓冲区未满
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+template <typename Arg>
+void RingDeque<ElementType, Policy, Allocator>::construct_front(Arg&& arg) {
+	const uint64_t head = (_head - 1) & (_capacity - 1);
+	AllocTraits::construct(_alloc, _buffer + head, std::forward<Arg>(arg));
+	_head = head;
+	++_size;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+bool RingDeque<ElementType, Policy, Allocator>::push_back(const ElementType& val) {
+	if (full()) {
+		if constexpr (Policy == OverflowPolicy::Overwrite) {
+			if (_capacity == 0) {
+				return false;
+			}
+			// 覆盖队首，队首后移一位
+			slot(0) = val;
+			_head = (_head + 1) & (_capacity - 1);
+			return true;
+		} else if constexpr (Policy == OverflowPolicy::Grow) {
+			// val 可能引用缓冲区中的元素，扩容会释放旧缓冲区，先复制一份
+			ElementType copy(val);
+			make_room();
+			AllocTraits::construct(_alloc, &slot(_size), std::move(copy));
+			++_size;
+			return true;
+		} else {
+			return false;
+		}
+	}
+	AllocTraits::construct(_alloc, &slot(_size), val);
+	++_size;
+	return true;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+bool RingDeque<ElementType, Policy, Allocator>::push_front(const ElementType& val) {
+	if (full()) {
+		if constexpr (Policy == OverflowPolicy::Overwrite) {
+			if (_capacity == 0) {
+				return false;
+			}
+			// 覆盖队尾，队首前移一位正好落在原队尾上
+			slot(_size - 1) = val;
+			_head = (_head - 1) & (_capacity - 1);
+			return true;
+		} else if constexpr (Policy == OverflowPolicy::Grow) {
+			ElementType copy(val); // 同 push_back，扩容前先复制
+			make_room();
+			construct_front(std::move(copy));
+			return true;
+		} else {
+			return false;
+		}
+	}
+	construct_front(val);
+	return true;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+void RingDeque<ElementType, Policy, Allocator>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	AllocTraits::destroy(_alloc, &slot(_size - 1));
+	--_size;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+void RingDeque<ElementType, Policy, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	AllocTraits::destroy(_alloc, &slot(0));
+	_head = (_head + 1) & (_capacity - 1);
+	--_size;
+}
+
+template <typename ElementType, OverflowPolicy Policy, typename Allocator>
+void RingDeque<ElementType, Policy, Allocator>::clear() {
+	for (uint64_t i = 0; i < _size; ++i) {
+		AllocTraits::destroy(_alloc, &slot(i));
+	}
+	_head = 0;
+	_size = 0;
+}
+}
+
+
+#endif //RINGDEQUE_HPP
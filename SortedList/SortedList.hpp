@@ -0,0 +1,523 @@
+#ifndef SORTEDLIST_HPP
+#define SORTEDLIST_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mystl {
+// 有序链表：第 0 层与 DoublyLinkedList 相同，是带哨兵的双向环形链表；
+// 较高的节点另外持有一组跳跃指针，查找、插入和按键删除都是期望 O(log n)。
+// 相等的元素按插入顺序排列在一起，语义同 std::multiset。
+template <typename ElementType, typename Compare = std::less<ElementType>, typename Allocator = std::allocator<ElementType>>
+struct SortedList {
+private:
+	static constexpr uint32_t max_level = 32;
+
+	// _up[i] 是第 i + 1 层的后继，塔顶之上的层没有分配；高层链表以 nullptr 结尾
+	struct SortedNodeBase {
+		SortedNodeBase* _prev = nullptr;
+		SortedNodeBase* _next = nullptr;
+		SortedNodeBase** _up = nullptr;
+		uint32_t _height = 1;
+	};
+
+	struct SortedNode : SortedNodeBase {
+		ElementType _val;
+
+		template <typename... Args>
+		explicit SortedNode(Args&&... args) : _val(std::forward<Args>(args)...) {}
+
+		SortedNode(const SortedNode& ano_node) = delete;
+		SortedNode& operator =(const SortedNode& ano_node) = delete;
+	};
+
+	using NodeBase = SortedNodeBase;
+	using Node = SortedNode;
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+	using TowerAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeBase*>;
+	using TowerAllocTraits = std::allocator_traits<TowerAllocator>;
+
+	// 每层上位于插入/删除位置之前的最后一个节点
+	using Predecessors = std::array<NodeBase*, max_level>;
+
+	// 元素决定了节点的位置，因此只提供只读访问
+	class Iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const ElementType*;
+		using reference = const ElementType&;
+
+		NodeBase* _current = nullptr;
+
+	public:
+		Iterator() = default;
+		explicit Iterator(NodeBase* pt) : _current{pt} {}
+
+	public:
+		const ElementType& operator*() const { return static_cast<Node*>(_current)->_val; }
+		const ElementType* operator->() const { return &static_cast<Node*>(_current)->_val; }
+
+		Iterator& operator++() {
+			_current = _current->_next;
+			return *this;
+		}
+
+		Iterator& operator--() {
+			_current = _current->_prev;
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator old = *this;
+			_current = _current->_next;
+			return old;
+		}
+
+		Iterator operator--(int) {
+			Iterator old = *this;
+			_current = _current->_prev;
+			return old;
+		}
+
+		bool operator!=(const Iterator& ano_iter) const { return _current != ano_iter._current; }
+		bool operator==(const Iterator& ano_iter) const { return _current == ano_iter._current; }
+	};
+
+public:
+	using iterator = Iterator;
+	using value_compare = Compare;
+	using allocator_type = Allocator;
+
+private:
+	uint64_t _size = 0;
+	uint32_t _level = 1; // 当前使用中的最高层数
+	uint64_t _rng_state = 0x2545f4914f6cdd1dULL;
+	NodeBase _sentinel;
+	std::array<NodeBase*, max_level - 1> _head_tower{};
+	[[no_unique_address]] Compare _comp;
+	[[no_unique_address]] NodeAllocator _alloc;
+
+	NodeBase* sentinel() const { return const_cast<NodeBase*>(&_sentinel); }
+	static const ElementType& value(NodeBase* node) { return static_cast<Node*>(node)->_val; }
+	static NodeBase*& forward(NodeBase* node, uint32_t level) { return level == 0 ? node->_next : node->_up[level - 1]; }
+	bool is_end(NodeBase* node) const { return node == nullptr || node == sentinel(); }
+
+	void reset_sentinel() noexcept;
+	void take_nodes(SortedList& ano_list) noexcept;
+	uint32_t random_height() noexcept;
+
+	template <typename... Args>
+	Node* create_node(Args&&... args);
+	void destroy_node(NodeBase* node) noexcept;
+
+	template <typename Before>
+	void find_predecessors(Before before, Predecessors& update) const;
+	void link_node(NodeBase* node, Predecessors& update) noexcept;
+	void unlink_node(NodeBase* node, const Predecessors& update) noexcept; // 只摘链，不释放
+
+	template <typename... Args>
+	Iterator emplace_node(Args&&... args);
+
+public:
+	SortedList() noexcept;
+	explicit SortedList(const Compare& comp, const Allocator& alloc = Allocator()) noexcept;
+	SortedList(std::initializer_list<ElementType> list, const Compare& comp = Compare());
+
+	SortedList(const SortedList& ano_list);
+	SortedList& operator=(const SortedList& ano_list);
+
+	SortedList(SortedList&& ano_list) noexcept;
+	SortedList& operator=(SortedList&& ano_list) noexcept;
+
+	~SortedList() { clear(); }
+
+public:
+	Iterator begin() const { return Iterator(_sentinel._next); }
+	Iterator end() const { return Iterator(sentinel()); }
+	const ElementType& front() const { return value(_sentinel._next); }
+	const ElementType& back() const { return value(_sentinel._prev); }
+	[[nodiscard]] uint64_t size() const { return _size; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+
+	Iterator insert(const ElementType& val) { return emplace_node(val); }
+	Iterator insert(ElementType&& val) { return emplace_node(std::move(val)); }
+
+	// 按有序输入一次归并插入，O(n + m)；输入中出现逆序时退回一次跳跃查找，结果仍然有序
+	template <typename Range>
+	void insert_sorted(const Range& range);
+
+	Iterator lower_bound(const ElementType& key) const;
+	Iterator upper_bound(const ElementType& key) const;
+	Iterator find(const ElementType& key) const;
+	[[nodiscard]] bool contains(const ElementType& key) const { return find(key) != end(); }
+
+	void pop_front();
+	void pop_back();
+
+	Iterator erase(Iterator it);
+	uint64_t erase(const ElementType& key);
+
+	void clear();
+
+	[[nodiscard]] value_compare value_comp() const { return _comp; }
+	[[nodiscard]] allocator_type get_allocator() const { return allocator_type(_alloc); }
+};
+
+template <typename ElementType, typename Compare, typename Allocator>
+SortedList<ElementType, Compare, Allocator>::SortedList() noexcept {
+	reset_sentinel();
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+SortedList<ElementType, Compare, Allocator>::SortedList(const Compare& comp, const Allocator& alloc) noexcept :
+	_comp{comp}, _alloc{alloc} {
+	reset_sentinel();
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+SortedList<ElementType, Compare, Allocator>::SortedList(std::initializer_list<ElementType> list, const Compare& comp) :
+	SortedList(comp) {
+	insert_sorted(list);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+SortedList<ElementType, Compare, Allocator>::SortedList(const SortedList& ano_list) :
+	SortedList(ano_list._comp, NodeAllocTraits::select_on_container_copy_construction(ano_list._alloc)) {
+	insert_sorted(ano_list); // 源已经有序，逐个追加到尾部
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+SortedList<ElementType, Compare, Allocator>& SortedList<ElementType, Compare, Allocator>::operator=(const SortedList& ano_list) {
+	if (this != &ano_list) {
+		clear();
+		if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value) {
+			_alloc = ano_list._alloc;
+		}
+		_comp = ano_list._comp;
+		insert_sorted(ano_list);
+	}
+	return *this;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+SortedList<ElementType, Compare, Allocator>::SortedList(SortedList&& ano_list) noexcept :
+	SortedList(ano_list._comp, std::move(ano_list._alloc)) {
+	take_nodes(ano_list);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+SortedList<ElementType, Compare, Allocator>& SortedList<ElementType, Compare, Allocator>::operator=(SortedList&& ano_list) noexcept {
+	if (this != &ano_list) {
+		clear();
+		if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value) {
+			_alloc = std::move(ano_list._alloc);
+		}
+		_comp = ano_list._comp;
+		take_nodes(ano_list);
+	}
+	return *this;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::reset_sentinel() noexcept {
+	_sentinel._prev = &_sentinel;
+	_sentinel._next = &_sentinel;
+	_sentinel._up = _head_tower.data();
+	_sentinel._height = max_level;
+	_head_tower.fill(nullptr);
+	_level = 1;
+	_size = 0;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::take_nodes(SortedList& ano_list) noexcept {
+	if (ano_list.empty()) {
+		reset_sentinel();
+		return;
+	}
+
+	// 高层以 nullptr 结尾，只有第 0 层的首尾节点需要改指到本对象的哨兵
+	_sentinel._next = ano_list._sentinel._next;
+	_sentinel._prev = ano_list._sentinel._prev;
+	_sentinel._next->_prev = &_sentinel;
+	_sentinel._prev->_next = &_sentinel;
+	_head_tower = ano_list._head_tower;
+	_level = ano_list._level;
+	_size = ano_list._size;
+
+	ano_list.reset_sentinel();
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+uint32_t SortedList<ElementType, Compare, Allocator>::random_height() noexcept {
+	// splitmix64；每两位随机数决定是否再长一层，即 p = 1/4
+	uint64_t z = (_rng_state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	z ^= z >> 31;
+	const auto height = 1 + static_cast<uint32_t>(std::countr_zero(z | (uint64_t{1} << 62))) / 2;
+	return height < max_level ? height : max_level;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+template <typename... Args>
+typename SortedList<ElementType, Compare, Allocator>::Node*
+SortedList<ElementType, Compare, Allocator>::create_node(Args&&... args) {
+	Node* node = NodeAllocTraits::allocate(_alloc, 1);
+	try {
+		NodeAllocTraits::construct(_alloc, node, std::forward<Args>(args)...);
+	} catch (...) {
+		NodeAllocTraits::deallocate(_alloc, node, 1);
+		throw;
+	}
+
+	// 约 3/4 的节点只有第 0 层，不需要额外分配塔
+	const uint32_t height = random_height();
+	if (height > 1) {
+		TowerAllocator tower_alloc(_alloc);
+		try {
+			node->_up = TowerAllocTraits::allocate(tower_alloc, height - 1);
+		} catch (...) {
+			NodeAllocTraits::destroy(_alloc, node);
+			NodeAllocTraits::deallocate(_alloc, node, 1);
+			throw;
+		}
+		node->_height = height;
+	}
+	return node;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::destroy_node(NodeBase* node) noexcept {
+	if (node->_height > 1) {
+		TowerAllocator tower_alloc(_alloc);
+		TowerAllocTraits::deallocate(tower_alloc, node->_up, node->_height - 1);
+	}
+	auto value_node = static_cast<Node*>(node);
+	NodeAllocTraits::destroy(_alloc, value_node);
+	NodeAllocTraits::deallocate(_alloc, value_node, 1);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+template <typename Before>
+void SortedList<ElementType, Compare, Allocator>::find_predecessors(Before before, Predecessors& update) const {
+	// 从最高层往下走，每层停在最后一个满足 before 的节点上
+	NodeBase* current = sentinel();
+	for (uint32_t level = _level; level-- > 0;) {
+		for (NodeBase* next_node = forward(current, level); !is_end(next_node) && before(value(next_node));
+		     next_node = forward(current, level)) {
+			current = next_node;
+		}
+		update[level] = current;
+	}
+	for (uint32_t level = _level; level < max_level; ++level) {
+		update[level] = sentinel();
+	}
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::link_node(NodeBase* node, Predecessors& update) noexcept {
+	if (node->_height > _level) {
+		_level = node->_height; // 更高的层上前驱只能是哨兵，update 中已经填好
+	}
+
+	NodeBase* prev_node = update[0];
+	node->_prev = prev_node;
+	node->_next = prev_node->_next;
+	prev_node->_next->_prev = node;
+	prev_node->_next = node;
+
+	for (uint32_t level = 1; level < node->_height; ++level) {
+		forward(node, level) = forward(update[level], level);
+		forward(update[level], level) = node;
+	}
+	++_size;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::unlink_node(NodeBase* node, const Predecessors& update) noexcept {
+	for (uint32_t level = 1; level < node->_height; ++level) {
+		forward(update[level], level) = forward(node, level);
+	}
+	node->_prev->_next = node->_next;
+	node->_next->_prev = node->_prev;
+
+	while (_level > 1 && _head_tower[_level - 2] == nullptr) {
+		--_level;
+	}
+	--_size;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+template <typename... Args>
+typename SortedList<ElementType, Compare, Allocator>::Iterator
+SortedList<ElementType, Compare, Allocator>::emplace_node(Args&&... args) {
+	Node* node = create_node(std::forward<Args>(args)...);
+
+	// 插到所有相等元素之后
+	Predecessors update;
+	find_predecessors([&](const ElementType& val) { return !_comp(node->_val, val); }, update);
+	link_node(node, update);
+	return Iterator(node);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+template <typename Range>
+void SortedList<ElementType, Compare, Allocator>::insert_sorted(const Range& range) {
+	if constexpr (std::is_same_v<Range, SortedList>) {
+		if (&range == this) {
+			// 插入自身时新节点会出现在遍历前方，遍历永远走不到尾部，先拷贝一份
+			insert_sorted(SortedList(range));
+			return;
+		}
+	}
+
+	// 游标只向后走，同时记录每层最后经过的节点，走过第 0 层一遍即可完成归并
+	Predecessors update;
+	update.fill(sentinel());
+	NodeBase* cursor = sentinel();
+
+	for (const auto& val : range) {
+		if (cursor != sentinel() && _comp(val, value(cursor))) {
+			// 输入逆序，重新定位游标
+			find_predecessors([&](const ElementType& existing) { return !_comp(val, existing); }, update);
+			cursor = update[0];
+		}
+		while (cursor->_next != sentinel() && !_comp(val, value(cursor->_next))) {
+			cursor = cursor->_next;
+			for (uint32_t level = 0; level < cursor->_height; ++level) {
+				update[level] = cursor;
+			}
+		}
+
+		Node* node = create_node(val);
+		link_node(node, update);
+		cursor = node;
+		for (uint32_t level = 0; level < node->_height; ++level) {
+			update[level] = node;
+		}
+	}
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+typename SortedList<ElementType, Compare, Allocator>::Iterator
+SortedList<ElementType, Compare, Allocator>::lower_bound(const ElementType& key) const {
+	Predecessors update;
+	find_predecessors([&](const ElementType& val) { return _comp(val, key); }, update);
+	return Iterator(update[0]->_next);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+typename SortedList<ElementType, Compare, Allocator>::Iterator
+SortedList<ElementType, Compare, Allocator>::upper_bound(const ElementType& key) const {
+	Predecessors update;
+	find_predecessors([&](const ElementType& val) { return !_comp(key, val); }, update);
+	return Iterator(update[0]->_next);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+typename SortedList<ElementType, Compare, Allocator>::Iterator
+SortedList<ElementType, Compare, Allocator>::find(const ElementType& key) const {
+	auto it = lower_bound(key);
+	if (it != end() && !_comp(key, *it)) {
+		return it;
+	}
+	return end();
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	// 首节点在每一层的前驱都是哨兵
+	Predecessors update;
+	update.fill(sentinel());
+	NodeBase* node = _sentinel._next;
+	unlink_node(node, update);
+	destroy_node(node);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	erase(Iterator(_sentinel._prev));
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+typename SortedList<ElementType, Compare, Allocator>::Iterator
+SortedList<ElementType, Compare, Allocator>::erase(Iterator it) {
+	NodeBase* node = it._current;
+	NodeBase* next_node = node->_next;
+
+	// 先定位到第一个与之相等的元素之前，再在每层向后找到该节点本身
+	Predecessors update;
+	if (node->_height > 1) {
+		const ElementType& key = value(node);
+		find_predecessors([&](const ElementType& val) { return _comp(val, key); }, update);
+		for (uint32_t level = 1; level < node->_height; ++level) {
+			while (forward(update[level], level) != node) {
+				update[level] = forward(update[level], level);
+			}
+		}
+	}
+	unlink_node(node, update);
+	destroy_node(node);
+	return Iterator(next_node);
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+uint64_t SortedList<ElementType, Compare, Allocator>::erase(const ElementType& key) {
+	Predecessors update;
+	find_predecessors([&](const ElementType& val) { return _comp(val, key); }, update);
+
+	// 删除后各层前驱不变，可以连续删除所有相等的元素；
+	// key 可能就是某个待删元素本身，该节点留到最后再释放
+	uint64_t removed = 0;
+	NodeBase* deferred = nullptr;
+	NodeBase* current = update[0]->_next;
+	while (current != sentinel() && !_comp(key, value(current))) {
+		NodeBase* next_node = current->_next;
+		unlink_node(current, update);
+		if (&value(current) == &key) {
+			deferred = current;
+		} else {
+			destroy_node(current);
+		}
+		current = next_node;
+		++removed;
+	}
+	if (deferred) {
+		destroy_node(deferred);
+	}
+	return removed;
+}
+
+template <typename ElementType, typename Compare, typename Allocator>
+void SortedList<ElementType, Compare, Allocator>::clear() {
+	NodeBase* current = _sentinel._next;
+	while (current != &_sentinel) {
+		NodeBase* next_node = current->_next;
+		destroy_node(current);
+		current = next_node;
+	}
+	reset_sentinel();
+}
+}
+
+
+#endif //SORTEDLIST_HPP
@@ -0,0 +1,431 @@
+#ifndef SPILLABLELIST_HPP
+#define SPILLABLELIST_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../RingDeque/RingDeque.hpp"
+
+namespace mystl {
+struct SpillOptions {
+	uint64_t segment_elements = 4096; // 每段的元素个数，也是文件中一个块的大小
+	uint64_t memory_segments = 16;    // 同时驻留内存的段数上限，至少为 2（首段和尾段）
+	uint64_t read_ahead = 4;          // 换入一段时预读其后多少段
+	std::filesystem::path directory = std::filesystem::temp_directory_path();
+};
+
+// 可溢出到磁盘的链表。元素按段组织，首尾两段始终在内存中；驻留段数超过上限时，
+// 刚写满的那一段（离两端最远、最晚才会被用到）整段写入临时文件的一个定长块。
+// pop_front/pop_back 取空一段后换入相邻段，并用 posix_fadvise 让内核提前读入后续几段，
+// 顺序消费和遍历都是流式的。文件块用空闲链表复用。只支持可平凡复制的元素。
+template <typename ElementType>
+class SpillableList {
+	static_assert(std::is_trivially_copyable_v<ElementType>, "spilled segments are stored as raw bytes");
+
+private:
+	struct Segment {
+		RingDeque<ElementType> _items; // 驻留时的元素
+		uint64_t _spilled_count = 0;
+		int64_t _chunk = -1; // 文件中的块号，-1 表示驻留内存
+
+		[[nodiscard]] bool spilled() const { return _chunk >= 0; }
+		[[nodiscard]] uint64_t size() const { return spilled() ? _spilled_count : _items.size(); }
+	};
+
+	// 只读的顺序迭代器，遇到已溢出的段时整段读入自己的缓冲区
+	class Iterator {
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const ElementType*;
+		using reference = const ElementType&;
+
+		const SpillableList* _list = nullptr;
+		uint64_t _segment = 0;
+		uint64_t _offset = 0;
+		std::shared_ptr<std::vector<ElementType>> _buffer;
+
+	public:
+		Iterator() = default;
+		Iterator(const SpillableList* list, uint64_t segment) : _list{list}, _segment{segment} { load(); }
+
+	public:
+		const ElementType& operator*() const;
+		const ElementType* operator->() const { return &**this; }
+
+		Iterator& operator++();
+		Iterator operator++(int) {
+			Iterator old = *this;
+			++*this;
+			return old;
+		}
+
+		bool operator!=(const Iterator& ano_iter) const { return !(*this == ano_iter); }
+		bool operator==(const Iterator& ano_iter) const {
+			return _segment == ano_iter._segment && _offset == ano_iter._offset;
+		}
+
+	private:
+		void load();
+	};
+
+public:
+	using iterator = Iterator;
+
+private:
+	SpillOptions _options;
+	RingDeque<Segment> _segments;
+	uint64_t _size = 0;
+	uint64_t _resident = 0; // 驻留内存的段数
+	uint64_t _spilled = 0;
+	int _fd = -1;
+	uint64_t _next_chunk = 0;
+	std::vector<uint64_t> _free_chunks;
+
+	[[nodiscard]] uint64_t chunk_bytes() const { return _options.segment_elements * sizeof(ElementType); }
+	[[nodiscard]] off_t chunk_offset(int64_t chunk) const { return static_cast<off_t>(chunk * chunk_bytes()); }
+
+	void open_file();
+	void spill(Segment& segment);
+	void load(Segment& segment);
+	void read_chunk(const Segment& segment, ElementType* out) const;
+	void advise(uint64_t first_segment, int64_t step) const;
+	Segment& new_segment(bool at_back);
+	void drop_segment(bool at_back);
+
+public:
+	explicit SpillableList(SpillOptions options = {});
+
+	SpillableList(const SpillableList& ano_list) = delete;
+	SpillableList& operator=(const SpillableList& ano_list) = delete;
+
+	SpillableList(SpillableList&& ano_list) noexcept;
+	SpillableList& operator=(SpillableList&& ano_list) noexcept;
+
+	~SpillableList();
+
+public:
+	Iterator begin() const { return Iterator(this, 0); }
+	Iterator end() const { return Iterator(this, _segments.size()); }
+	// 首尾段总在内存中，返回的引用在下一次修改前有效
+	const ElementType& front() const { return _segments.front()._items.front(); }
+	const ElementType& back() const { return _segments.back()._items.back(); }
+	[[nodiscard]] uint64_t size() const { return _size; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+
+	void push_front(const ElementType& val);
+	void push_back(const ElementType& val);
+
+	void pop_back();
+	void pop_front();
+
+	void clear();
+
+	[[nodiscard]] uint64_t resident_segments() const { return _resident; }
+	[[nodiscard]] uint64_t spilled_segments() const { return _spilled; }
+	[[nodiscard]] uint64_t bytes_on_disk() const { return _spilled * chunk_bytes(); }
+	[[nodiscard]] const SpillOptions& options() const { return _options; }
+};
+
+template <typename ElementType>
+SpillableList<ElementType>::SpillableList(SpillOptions options) : _options{std::move(options)} {
+	if (_options.segment_elements == 0) {
+		throw std::invalid_argument("segment_elements must be positive.");
+	}
+	if (_options.memory_segments < 2) {
+		_options.memory_segments = 2;
+	}
+}
+
+template <typename ElementType>
+SpillableList<ElementType>::SpillableList(SpillableList&& ano_list) noexcept :
+	_options{std::move(ano_list._options)},
+	_segments{std::move(ano_list._segments)},
+	_size{std::exchange(ano_list._size, 0)},
+	_resident{std::exchange(ano_list._resident, 0)},
+	_spilled{std::exchange(ano_list._spilled, 0)},
+	_fd{std::exchange(ano_list._fd, -1)},
+	_next_chunk{std::exchange(ano_list._next_chunk, 0)},
+	_free_chunks{std::move(ano_list._free_chunks)} {}
+
+template <typename ElementType>
+SpillableList<ElementType>& SpillableList<ElementType>::operator=(SpillableList&& ano_list) noexcept {
+	if (this != &ano_list) {
+		if (_fd >= 0) {
+			::close(_fd);
+		}
+		_options = std::move(ano_list._options);
+		_segments = std::move(ano_list._segments);
+		_size = std::exchange(ano_list._size, 0);
+		_resident = std::exchange(ano_list._resident, 0);
+		_spilled = std::exchange(ano_list._spilled, 0);
+		_fd = std::exchange(ano_list._fd, -1);
+		_next_chunk = std::exchange(ano_list._next_chunk, 0);
+		_free_chunks = std::move(ano_list._free_chunks);
+	}
+	return *this;
+}
+
+template <typename ElementType>
+SpillableList<ElementType>::~SpillableList() {
+	if (_fd >= 0) {
+		::close(_fd);
+	}
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::open_file() {
+	// 创建后立即删除目录项，文件随描述符关闭自动回收，进程崩溃也不会留下垃圾
+	std::string path = (_options.directory / "spillable-list-XXXXXX").string();
+	_fd = ::mkstemp(path.data());
+	if (_fd < 0) {
+		throw std::system_error(errno, std::generic_category(), "Cannot create spill file");
+	}
+	::unlink(path.c_str());
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::spill(Segment& segment) {
+	if (_fd < 0) {
+		open_file();
+	}
+
+	int64_t chunk;
+	if (!_free_chunks.empty()) {
+		chunk = static_cast<int64_t>(_free_chunks.back());
+		_free_chunks.pop_back();
+	} else {
+		chunk = static_cast<int64_t>(_next_chunk++);
+	}
+
+	// 环形缓冲区不一定连续，先展开再整块写入
+	std::vector<ElementType> staging(segment._items.begin(), segment._items.end());
+	const auto* data = reinterpret_cast<const char*>(staging.data());
+	std::size_t remaining = staging.size() * sizeof(ElementType);
+	off_t offset = chunk_offset(chunk);
+	while (remaining > 0) {
+		const ssize_t written = ::pwrite(_fd, data, remaining, offset);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			_free_chunks.push_back(static_cast<uint64_t>(chunk));
+			throw std::system_error(errno, std::generic_category(), "Cannot write spill file");
+		}
+		data += written;
+		offset += written;
+		remaining -= static_cast<std::size_t>(written);
+	}
+
+	segment._spilled_count = staging.size();
+	segment._chunk = chunk;
+	segment._items = RingDeque<ElementType>(); // 归还内存
+	--_resident;
+	++_spilled;
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::read_chunk(const Segment& segment, ElementType* out) const {
+	auto* data = reinterpret_cast<char*>(out);
+	std::size_t remaining = segment._spilled_count * sizeof(ElementType);
+	off_t offset = chunk_offset(segment._chunk);
+	while (remaining > 0) {
+		const ssize_t got = ::pread(_fd, data, remaining, offset);
+		if (got < 0 && errno == EINTR) {
+			continue;
+		}
+		if (got <= 0) {
+			throw std::system_error(got < 0 ? errno : EIO, std::generic_category(), "Cannot read spill file");
+		}
+		data += got;
+		offset += got;
+		remaining -= static_cast<std::size_t>(got);
+	}
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::load(Segment& segment) {
+	if (!segment.spilled()) {
+		return;
+	}
+	std::vector<ElementType> staging(segment._spilled_count);
+	read_chunk(segment, staging.data());
+
+	RingDeque<ElementType> items(_options.segment_elements);
+	for (const auto& val : staging) {
+		items.push_back(val);
+	}
+	segment._items = std::move(items);
+	_free_chunks.push_back(static_cast<uint64_t>(segment._chunk));
+	segment._chunk = -1;
+	segment._spilled_count = 0;
+	++_resident;
+	--_spilled;
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::advise(uint64_t first_segment, int64_t step) const {
+#ifdef POSIX_FADV_WILLNEED
+	// 让内核异步读入接下来要用到的块，真正换入时直接命中页缓存
+	auto index = static_cast<int64_t>(first_segment);
+	for (uint64_t i = 0; i < _options.read_ahead; ++i, index += step) {
+		if (index < 0 || index >= static_cast<int64_t>(_segments.size())) {
+			break;
+		}
+		const Segment& segment = _segments[static_cast<uint64_t>(index)];
+		if (segment.spilled()) {
+			::posix_fadvise(_fd, chunk_offset(segment._chunk), static_cast<off_t>(chunk_bytes()), POSIX_FADV_WILLNEED);
+		}
+	}
+#else
+	(void)first_segment;
+	(void)step;
+#endif
+}
+
+template <typename ElementType>
+typename SpillableList<ElementType>::Segment& SpillableList<ElementType>::new_segment(bool at_back) {
+	if (at_back) {
+		_segments.push_back(Segment{});
+	} else {
+		_segments.push_front(Segment{});
+	}
+	(at_back ? _segments.back() : _segments.front())._items.reserve(_options.segment_elements);
+	++_resident;
+
+	// 超出驻留上限时，把刚写满的相邻段换出；它离两端最远，最晚才会被消费
+	if (_resident > _options.memory_segments && _segments.size() >= 3) {
+		Segment& closed = at_back ? _segments[_segments.size() - 2] : _segments[1];
+		if (!closed.spilled()) {
+			spill(closed);
+		}
+	}
+	return at_back ? _segments.back() : _segments.front();
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::drop_segment(bool at_back) {
+	if (at_back) {
+		_segments.pop_back();
+	} else {
+		_segments.pop_front();
+	}
+	--_resident;
+
+	// 新的端点段必须驻留，并预读它之后的几段
+	if (!_segments.empty()) {
+		load(at_back ? _segments.back() : _segments.front());
+		if (at_back) {
+			advise(_segments.size() - 1, -1);
+		} else {
+			advise(1, 1);
+		}
+	}
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::push_back(const ElementType& val) {
+	if (_segments.empty() || _segments.back()._items.size() == _options.segment_elements) {
+		new_segment(true)._items.push_back(val);
+	} else {
+		_segments.back()._items.push_back(val);
+	}
+	++_size;
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::push_front(const ElementType& val) {
+	if (_segments.empty() || _segments.front()._items.size() == _options.segment_elements) {
+		new_segment(false)._items.push_front(val);
+	} else {
+		_segments.front()._items.push_front(val);
+	}
+	++_size;
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	_segments.front()._items.pop_front();
+	--_size;
+	if (_segments.front()._items.empty()) {
+		drop_segment(false);
+	}
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	_segments.back()._items.pop_back();
+	--_size;
+	if (_segments.back()._items.empty()) {
+		drop_segment(true);
+	}
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::clear() {
+	_segments.clear();
+	_size = 0;
+	_resident = 0;
+	_spilled = 0;
+	_next_chunk = 0;
+	_free_chunks.clear();
+	if (_fd >= 0 && ::ftruncate(_fd, 0) != 0) {
+		throw std::system_error(errno, std::generic_category(), "Cannot truncate spill file");
+	}
+}
+
+template <typename ElementType>
+const ElementType& SpillableList<ElementType>::Iterator::operator*() const {
+	if (_buffer) {
+		return (*_buffer)[_offset];
+	}
+	return _list->_segments[_segment]._items[_offset];
+}
+
+template <typename ElementType>
+typename SpillableList<ElementType>::Iterator& SpillableList<ElementType>::Iterator::operator++() {
+	if (++_offset == _list->_segments[_segment].size()) {
+		++_segment;
+		_offset = 0;
+		load();
+	}
+	return *this;
+}
+
+template <typename ElementType>
+void SpillableList<ElementType>::Iterator::load() {
+	_buffer.reset();
+	if (_segment >= _list->_segments.size()) {
+		return;
+	}
+	const Segment& segment = _list->_segments[_segment];
+	if (segment.spilled()) {
+		_buffer = std::make_shared<std::vector<ElementType>>(segment._spilled_count);
+		_list->read_chunk(segment, _buffer->data());
+		_list->advise(_segment + 1, 1);
+	}
+}
+}
+
+
+#endif //SPILLABLELIST_HPP
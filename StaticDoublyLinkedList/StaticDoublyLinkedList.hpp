@@ -0,0 +1,218 @@
+#ifndef STATICDOUBLYLINKEDLIST_HPP
+#define STATICDOUBLYLINKEDLIST_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mystl {
+// 容量固定的双向链表，所有操作都是 constexpr，可以在编译期构造并放进只读数据段。
+// 元素和链接分别存放在两个 std::array 中，链接是下标而不是指针；下标 Capacity 是哨兵。
+// 空闲槽位通过 _next 串成单链表。ElementType 需要可默认构造、可赋值。
+template <typename ElementType, std::size_t Capacity>
+struct StaticDoublyLinkedList {
+	static_assert(Capacity > 0 && Capacity < UINT32_MAX, "capacity must fit in a 32-bit index");
+
+private:
+	// 容量较小时用 16 位下标，两条链接只占 4 字节
+	using index_type = std::conditional_t<(Capacity < UINT16_MAX), uint16_t, uint32_t>;
+
+	static constexpr index_type sentinel = static_cast<index_type>(Capacity);
+
+	struct Link {
+		index_type _prev = sentinel;
+		index_type _next = sentinel;
+	};
+
+	template <bool IsConst>
+	class BasicIterator {
+		using ListPointer = std::conditional_t<IsConst, const StaticDoublyLinkedList*, StaticDoublyLinkedList*>;
+
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IsConst, const ElementType*, ElementType*>;
+		using reference = std::conditional_t<IsConst, const ElementType&, ElementType&>;
+
+		ListPointer _list = nullptr;
+		index_type _current = sentinel;
+
+	public:
+		constexpr BasicIterator() = default;
+		constexpr BasicIterator(ListPointer list, index_type current) : _list{list}, _current{current} {}
+
+		// 可变迭代器可以隐式转换为只读迭代器
+		constexpr operator BasicIterator<true>() const requires (!IsConst) { return {_list, _current}; }
+
+	public:
+		constexpr reference operator*() const { return _list->_values[_current]; }
+		constexpr pointer operator->() const { return &_list->_values[_current]; }
+
+		constexpr BasicIterator& operator++() {
+			_current = _list->_links[_current]._next;
+			return *this;
+		}
+
+		constexpr BasicIterator& operator--() {
+			_current = _list->_links[_current]._prev;
+			return *this;
+		}
+
+		constexpr BasicIterator operator++(int) {
+			BasicIterator old = *this;
+			++*this;
+			return old;
+		}
+
+		constexpr BasicIterator operator--(int) {
+			BasicIterator old = *this;
+			--*this;
+			return old;
+		}
+
+		constexpr bool operator!=(const BasicIterator& ano_iter) const { return _current != ano_iter._current; }
+		constexpr bool operator==(const BasicIterator& ano_iter) const { return _current == ano_iter._current; }
+	};
+
+public:
+	using iterator = BasicIterator<false>;
+	using const_iterator = BasicIterator<true>;
+
+private:
+	std::array<ElementType, Capacity> _values{};
+	std::array<Link, Capacity + 1> _links{};
+	index_type _free = 0; // 空闲槽位链表的头，sentinel 表示已满
+	index_type _size = 0;
+
+	constexpr index_type allocate_slot(const ElementType& val);
+	constexpr void link_before(index_type pos, index_type slot);
+	constexpr void unlink(index_type slot);
+
+public:
+	constexpr StaticDoublyLinkedList();
+	constexpr StaticDoublyLinkedList(std::initializer_list<ElementType> list);
+
+public:
+	constexpr iterator begin() { return iterator(this, _links[sentinel]._next); }
+	constexpr iterator end() { return iterator(this, sentinel); }
+	constexpr const_iterator begin() const { return const_iterator(this, _links[sentinel]._next); }
+	constexpr const_iterator end() const { return const_iterator(this, sentinel); }
+
+	constexpr const ElementType& front() const { return _values[_links[sentinel]._next]; }
+	constexpr const ElementType& back() const { return _values[_links[sentinel]._prev]; }
+	[[nodiscard]] constexpr uint64_t size() const { return _size; }
+	[[nodiscard]] constexpr bool empty() const { return _size == 0; }
+	[[nodiscard]] constexpr bool full() const { return _size == Capacity; }
+	[[nodiscard]] static constexpr uint64_t capacity() { return Capacity; }
+
+	// 容量用完时抛出 std::length_error；在常量求值中这会变成编译错误
+	constexpr void push_front(const ElementType& val) { link_before(_links[sentinel]._next, allocate_slot(val)); }
+	constexpr void push_back(const ElementType& val) { link_before(sentinel, allocate_slot(val)); }
+	constexpr iterator insert(const_iterator it, const ElementType& val);
+
+	constexpr void pop_back();
+	constexpr void pop_front();
+	constexpr iterator erase(const_iterator it);
+
+	constexpr void clear();
+};
+
+template <typename ElementType, std::size_t Capacity>
+constexpr StaticDoublyLinkedList<ElementType, Capacity>::StaticDoublyLinkedList() {
+	clear();
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr StaticDoublyLinkedList<ElementType, Capacity>::StaticDoublyLinkedList(std::initializer_list<ElementType> list) :
+	StaticDoublyLinkedList() {
+	for (const auto& val : list) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr typename StaticDoublyLinkedList<ElementType, Capacity>::index_type
+StaticDoublyLinkedList<ElementType, Capacity>::allocate_slot(const ElementType& val) {
+	if (_free == sentinel) {
+		throw std::length_error("StaticDoublyLinkedList capacity exceeded.");
+	}
+	const index_type slot = _free;
+	_free = _links[slot]._next;
+	_values[slot] = val;
+	return slot;
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr void StaticDoublyLinkedList<ElementType, Capacity>::link_before(index_type pos, index_type slot) {
+	_links[slot]._prev = _links[pos]._prev;
+	_links[slot]._next = pos;
+	_links[_links[pos]._prev]._next = slot;
+	_links[pos]._prev = slot;
+	++_size;
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr void StaticDoublyLinkedList<ElementType, Capacity>::unlink(index_type slot) {
+	_links[_links[slot]._prev]._next = _links[slot]._next;
+	_links[_links[slot]._next]._prev = _links[slot]._prev;
+
+	// 槽位归还到空闲链表，元素重置为默认值，释放它持有的资源
+	_values[slot] = ElementType{};
+	_links[slot]._next = _free;
+	_free = slot;
+	--_size;
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr typename StaticDoublyLinkedList<ElementType, Capacity>::iterator
+StaticDoublyLinkedList<ElementType, Capacity>::insert(const_iterator it, const ElementType& val) {
+	const index_type slot = allocate_slot(val);
+	link_before(it._current, slot);
+	return iterator(this, slot);
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr void StaticDoublyLinkedList<ElementType, Capacity>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	unlink(_links[sentinel]._prev);
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr void StaticDoublyLinkedList<ElementType, Capacity>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	unlink(_links[sentinel]._next);
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr typename StaticDoublyLinkedList<ElementType, Capacity>::iterator
+StaticDoublyLinkedList<ElementType, Capacity>::erase(const_iterator it) {
+	const index_type next_slot = _links[it._current]._next;
+	unlink(it._current);
+	return iterator(this, next_slot);
+}
+
+template <typename ElementType, std::size_t Capacity>
+constexpr void StaticDoublyLinkedList<ElementType, Capacity>::clear() {
+	// 所有槽位按下标顺序串成空闲链表，保证按顺序追加时元素在数组中也是连续的
+	for (std::size_t i = 0; i < Capacity; ++i) {
+		_values[i] = ElementType{};
+		_links[i]._prev = sentinel;
+		_links[i]._next = static_cast<index_type>(i + 1);
+	}
+	_links[sentinel] = Link{sentinel, sentinel};
+	_free = 0;
+	_size = 0;
+}
+}
+
+
+#endif //STATICDOUBLYLINKEDLIST_HPP
@@ -0,0 +1,305 @@
+#ifndef THREADCACHEALLOCATOR_HPP
+#define THREADCACHEALLOCATOR_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace mystl {
+namespace thread_cache_detail {
+inline constexpr std::size_t slab_bytes = std::size_t{64} << 10; // slab 按自身大小对齐，块地址取整即可找到 slab 头
+inline constexpr std::size_t slab_header_bytes = 64;
+inline constexpr std::size_t remote_batch_size = 64; // 攒够这么多远端释放才交还一次
+inline constexpr std::size_t remote_slot_count = 8; // 同时攒批的远端线程数
+inline constexpr std::size_t max_pooled_bytes = 1024;
+
+struct FreeBlock {
+	FreeBlock* _next;
+};
+
+// 每个线程一个堆：本地空闲链表只由所属线程访问，其他线程释放的块通过 _inbox 整批交还。
+// _inbox 独占一个缓存行，远端线程的 CAS 不会让所属线程的本地字段所在的行失效
+struct ThreadHeap {
+	FreeBlock* _local = nullptr;
+	char* _cursor = nullptr;
+	char* _limit = nullptr;
+	alignas(64) std::atomic<FreeBlock*> _inbox{nullptr};
+};
+
+inline void push_inbox(ThreadHeap* owner, FreeBlock* head, FreeBlock* tail) noexcept {
+	FreeBlock* first = owner->_inbox.load(std::memory_order_relaxed);
+	do {
+		tail->_next = first;
+	} while (!owner->_inbox.compare_exchange_weak(first, head, std::memory_order_release, std::memory_order_relaxed));
+}
+
+struct SlabHeader {
+	ThreadHeap* _owner;
+};
+
+inline ThreadHeap* owner_of(void* block) {
+	const auto address = reinterpret_cast<std::uintptr_t>(block) & ~(slab_bytes - 1);
+	return reinterpret_cast<SlabHeader*>(address)->_owner;
+}
+
+struct RemoteBatch {
+	ThreadHeap* _owner = nullptr;
+	FreeBlock* _head = nullptr;
+	FreeBlock* _tail = nullptr;
+	std::size_t _count = 0;
+};
+}
+
+// 按块大小划分的全局池。每个线程从自己的堆分配；释放时若块属于其他线程，
+// 先按所属线程攒成一批，再用一次 CAS 挂到对方的 _inbox 上，对方分配时一次性取回。
+// 线程退出时堆被挂起，由之后新建的线程接管，所以块可以比分配它的线程活得更久。
+// 线程局部上下文析构之后（例如比它先构造的 thread_local 容器在析构时）仍可分配和释放：
+// 释放直接挂到所属堆的 _inbox，分配在锁内借用一个挂起的堆。
+template <std::size_t BlockBytes>
+class ThreadCachePool {
+public:
+	static void* allocate();
+	static void deallocate(void* ptr) noexcept;
+
+	// 立即交还本线程攒着的远端释放，例如消费者线程即将空闲时
+	static void flush_remote() noexcept {
+		if (!context_destroyed()) {
+			context().flush_all();
+		}
+	}
+
+private:
+	using ThreadHeap = thread_cache_detail::ThreadHeap;
+	using FreeBlock = thread_cache_detail::FreeBlock;
+	using RemoteBatch = thread_cache_detail::RemoteBatch;
+
+	struct ThreadContext {
+		ThreadHeap* _heap = nullptr;
+		std::array<RemoteBatch, thread_cache_detail::remote_slot_count> _pending{};
+
+		ThreadContext() = default;
+		ThreadContext(const ThreadContext&) = delete;
+		ThreadContext& operator=(const ThreadContext&) = delete;
+		~ThreadContext();
+
+		ThreadHeap& heap();
+		void free_remote(ThreadHeap* owner, FreeBlock* block) noexcept;
+		void flush(RemoteBatch& batch) noexcept;
+		void flush_all() noexcept;
+	};
+
+	static ThreadContext& context() {
+		static thread_local ThreadContext ctx;
+		return ctx;
+	}
+
+	// 平凡类型的 thread_local 没有析构，线程退出的任何阶段都可以读
+	static bool& context_destroyed() noexcept {
+		static thread_local bool destroyed = false;
+		return destroyed;
+	}
+
+	// 被退出线程挂起的堆；池与堆在进程生命周期内都不释放
+	static std::mutex& abandoned_mutex() {
+		static std::mutex mutex;
+		return mutex;
+	}
+
+	static std::vector<ThreadHeap*>& abandoned() {
+		static auto* heaps = new std::vector<ThreadHeap*>();
+		return *heaps;
+	}
+
+	static void* take(ThreadHeap& heap);
+	static void* carve(ThreadHeap& heap);
+	static void* allocate_orphaned();
+};
+
+template <std::size_t BlockBytes>
+ThreadCachePool<BlockBytes>::ThreadContext::~ThreadContext() {
+	context_destroyed() = true;
+	flush_all();
+	if (_heap) {
+		std::lock_guard lock(abandoned_mutex());
+		abandoned().push_back(std::exchange(_heap, nullptr));
+	}
+}
+
+template <std::size_t BlockBytes>
+typename ThreadCachePool<BlockBytes>::ThreadHeap& ThreadCachePool<BlockBytes>::ThreadContext::heap() {
+	if (!_heap) {
+		{
+			std::lock_guard lock(abandoned_mutex());
+			if (!abandoned().empty()) {
+				_heap = abandoned().back();
+				abandoned().pop_back();
+			}
+		}
+		if (!_heap) {
+			_heap = new ThreadHeap();
+		}
+	}
+	return *_heap;
+}
+
+template <std::size_t BlockBytes>
+void ThreadCachePool<BlockBytes>::ThreadContext::free_remote(ThreadHeap* owner, FreeBlock* block) noexcept {
+	// 直接映射到一个攒批槽位，槽位被其他线程占用时先把旧批次交还
+	const auto slot = (reinterpret_cast<std::uintptr_t>(owner) / alignof(ThreadHeap)) % _pending.size();
+	RemoteBatch& batch = _pending[slot];
+	if (batch._owner != owner) {
+		flush(batch);
+		batch._owner = owner;
+	}
+
+	block->_next = batch._head;
+	batch._head = block;
+	if (!batch._tail) {
+		batch._tail = block;
+	}
+	if (++batch._count >= thread_cache_detail::remote_batch_size) {
+		flush(batch);
+	}
+}
+
+template <std::size_t BlockBytes>
+void ThreadCachePool<BlockBytes>::ThreadContext::flush(RemoteBatch& batch) noexcept {
+	if (batch._head) {
+		// 整条链一次性挂到所属线程的收件箱上
+		thread_cache_detail::push_inbox(batch._owner, batch._head, batch._tail);
+	}
+	batch = RemoteBatch{};
+}
+
+template <std::size_t BlockBytes>
+void ThreadCachePool<BlockBytes>::ThreadContext::flush_all() noexcept {
+	for (auto& batch : _pending) {
+		flush(batch);
+	}
+}
+
+template <std::size_t BlockBytes>
+void* ThreadCachePool<BlockBytes>::carve(ThreadHeap& heap) {
+	if (heap._cursor + BlockBytes > heap._limit) {
+		auto slab = static_cast<char*>(::operator new(thread_cache_detail::slab_bytes,
+		                                              std::align_val_t{thread_cache_detail::slab_bytes}));
+		reinterpret_cast<thread_cache_detail::SlabHeader*>(slab)->_owner = &heap;
+		heap._cursor = slab + thread_cache_detail::slab_header_bytes;
+		heap._limit = slab + thread_cache_detail::slab_bytes;
+	}
+	void* block = heap._cursor;
+	heap._cursor += BlockBytes;
+	return block;
+}
+
+template <std::size_t BlockBytes>
+void* ThreadCachePool<BlockBytes>::allocate_orphaned() {
+	std::lock_guard lock(abandoned_mutex());
+	if (abandoned().empty()) {
+		auto heap = std::make_unique<ThreadHeap>();
+		abandoned().push_back(heap.get());
+		heap.release();
+	}
+	return take(*abandoned().back());
+}
+
+template <std::size_t BlockBytes>
+void* ThreadCachePool<BlockBytes>::allocate() {
+	if (context_destroyed()) {
+		return allocate_orphaned();
+	}
+	return take(context().heap());
+}
+
+template <std::size_t BlockBytes>
+void* ThreadCachePool<BlockBytes>::take(ThreadHeap& heap) {
+	// 本地空闲链表为空时，一次取回其他线程交还的全部块
+	if (!heap._local) {
+		heap._local = heap._inbox.exchange(nullptr, std::memory_order_acquire);
+	}
+	if (heap._local) {
+		FreeBlock* block = heap._local;
+		heap._local = block->_next;
+		return block;
+	}
+	return carve(heap);
+}
+
+template <std::size_t BlockBytes>
+void ThreadCachePool<BlockBytes>::deallocate(void* ptr) noexcept {
+	ThreadHeap* owner = thread_cache_detail::owner_of(ptr);
+	auto block = static_cast<FreeBlock*>(ptr);
+	if (context_destroyed()) {
+		thread_cache_detail::push_inbox(owner, block, block);
+		return;
+	}
+
+	ThreadContext& ctx = context();
+	if (owner == ctx._heap) {
+		block->_next = owner->_local;
+		owner->_local = block;
+	} else {
+		ctx.free_remote(owner, block);
+	}
+}
+
+// 标准分配器接口：单个小对象走线程缓存池，其余请求直接交给 operator new
+template <typename T>
+class ThreadCacheAllocator {
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+
+	ThreadCacheAllocator() noexcept = default;
+
+	template <typename U>
+	ThreadCacheAllocator(const ThreadCacheAllocator<U>&) noexcept {}
+
+	T* allocate(std::size_t n);
+	void deallocate(T* ptr, std::size_t n) noexcept;
+
+	static void flush_remote() noexcept {
+		if constexpr (pooled) {
+			Pool::flush_remote();
+		}
+	}
+
+	template <typename U>
+	bool operator==(const ThreadCacheAllocator<U>&) const noexcept { return true; }
+
+private:
+	static constexpr std::size_t block_bytes = (sizeof(T) + 15) / 16 * 16;
+	static constexpr bool pooled = block_bytes <= thread_cache_detail::max_pooled_bytes && alignof(T) <= 16;
+	using Pool = ThreadCachePool<block_bytes>;
+};
+
+template <typename T>
+T* ThreadCacheAllocator<T>::allocate(std::size_t n) {
+	if constexpr (pooled) {
+		if (n == 1) {
+			return static_cast<T*>(Pool::allocate());
+		}
+	}
+	return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+}
+
+template <typename T>
+void ThreadCacheAllocator<T>::deallocate(T* ptr, std::size_t n) noexcept {
+	if constexpr (pooled) {
+		if (n == 1) {
+			Pool::deallocate(ptr);
+			return;
+		}
+	}
+	::operator delete(ptr, std::align_val_t{alignof(T)});
+}
+}
+
+
+#endif //THREADCACHEALLOCATOR_HPP
@@ -0,0 +1,387 @@
+#ifndef TIMINGWHEEL_HPP
+#define TIMINGWHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace mystl {
+// 分层时间轮。每个槽是一条与 DoublyLinkedList 相同的带哨兵双向环形链表，
+// schedule 与 cancel 都是 O(1)；advance 按刻度推进，低层转满一圈时把高层对应槽的定时器重新分配到低层。
+// 第 l 层的每个槽覆盖 2^(SlotBits * l) 个刻度，超出总范围的定时器先挂在最高层，级联时再重新计算。
+// 每层用一张占用位图跳过空槽，advance 直接跳到下一个有定时器到期或需要级联的刻度，不逐个刻度空转。
+// 与链表一样不是线程安全的。
+template <typename ElementType, uint32_t SlotBits = 8, uint32_t Levels = 4, typename Allocator = std::allocator<ElementType>>
+class TimingWheel {
+	static_assert(SlotBits > 0 && Levels > 0 && SlotBits * Levels < 64, "wheel range must fit in 64 bits");
+
+private:
+	struct TimerNodeBase {
+		TimerNodeBase* _prev = nullptr;
+		TimerNodeBase* _next = nullptr;
+	};
+
+	// 节点在空闲链表和槽之间循环使用，_val 只在定时器挂起期间存活；
+	// 每次回收都递增代数，旧句柄因此不会误删复用后的节点
+	struct TimerNode : TimerNodeBase {
+		uint64_t _expiry = 0;
+		uint64_t _generation = 0;
+		union {
+			ElementType _val;
+		};
+
+		TimerNode() {}
+		~TimerNode() {}
+	};
+
+	using NodeBase = TimerNodeBase;
+	using Node = TimerNode;
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+
+	static constexpr uint64_t slot_count = uint64_t{1} << SlotBits;
+	static constexpr uint64_t slot_mask = slot_count - 1;
+	static constexpr uint64_t max_delta = (uint64_t{1} << (SlotBits * Levels)) - 1;
+	static constexpr uint64_t word_bits = slot_count < 64 ? slot_count : 64;
+	static constexpr uint64_t word_count = slot_count / word_bits;
+
+public:
+	// 定时器句柄，可以安全地比定时器本身活得更久
+	class TimerHandle {
+	public:
+		TimerHandle() noexcept = default;
+
+	private:
+		friend class TimingWheel;
+
+		TimerHandle(Node* node, uint64_t generation) noexcept : _node{node}, _generation{generation} {}
+
+		Node* _node = nullptr;
+		uint64_t _generation = 0;
+	};
+
+	using timer_handle = TimerHandle;
+	using allocator_type = Allocator;
+
+private:
+	std::array<std::array<NodeBase, slot_count>, Levels> _slots;
+	// 槽非空时对应位一定置位；cancel 不清位，查找时遇到已经变空的槽再清掉
+	std::array<std::array<uint64_t, word_count>, Levels> _occupied{};
+	uint64_t _now;
+	uint64_t _size = 0;
+	Node* _free = nullptr; // 通过 _next 串起来的空闲节点
+	NodeBase* _firing = nullptr; // 正在触发的一批定时器的局部哨兵，回调中 clear 时一并清空
+	[[no_unique_address]] NodeAllocator _alloc;
+
+	Node* acquire_node();
+	void release_node(Node* node) noexcept;
+	void place(Node* node) noexcept;
+	void cascade(uint32_t level, uint64_t slot) noexcept;
+	void mark(uint32_t level, uint64_t slot) noexcept { _occupied[level][slot / word_bits] |= uint64_t{1} << (slot % word_bits); }
+	void unmark(uint32_t level, uint64_t slot) noexcept { _occupied[level][slot / word_bits] &= ~(uint64_t{1} << (slot % word_bits)); }
+	uint64_t next_occupied(uint32_t level, uint64_t from) noexcept;
+	uint64_t next_event() noexcept;
+	template <typename Function>
+	void expire(NodeBase& slot, Function& on_expire);
+
+	static void link_before(NodeBase* pos, NodeBase* node) noexcept;
+	static void unlink(NodeBase* node) noexcept;
+
+public:
+	explicit TimingWheel(uint64_t now = 0, const Allocator& alloc = Allocator());
+
+	// 槽的哨兵嵌在对象内，因此不可拷贝也不可移动
+	TimingWheel(const TimingWheel& ano_wheel) = delete;
+	TimingWheel& operator=(const TimingWheel& ano_wheel) = delete;
+
+	~TimingWheel();
+
+public:
+	[[nodiscard]] uint64_t now() const { return _now; }
+	[[nodiscard]] uint64_t size() const { return _size; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+
+	// 在第 expiry 个刻度到期；不晚于当前时刻的定时器在下一个刻度到期
+	TimerHandle schedule_at(uint64_t expiry, const ElementType& val);
+	TimerHandle schedule(uint64_t delay, const ElementType& val) { return schedule_at(_now + delay, val); }
+
+	// 定时器已经到期或已被取消时返回 false
+	bool cancel(const TimerHandle& handle) noexcept;
+	[[nodiscard]] bool pending(const TimerHandle& handle) const noexcept;
+
+	// 推进到 now，按到期顺序对每个到期的元素调用 on_expire(ElementType&&)，返回到期个数。
+	// 回调中可以再 schedule、cancel 或 clear，包括取消同一刻度上尚未触发的定时器。
+	// 回调抛出异常时推进停在当前刻度，本刻度尚未触发的定时器顺延一个刻度，仍然可以取消
+	template <typename Function>
+	uint64_t advance(uint64_t now, Function on_expire);
+
+	void clear();
+};
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+TimingWheel<ElementType, SlotBits, Levels, Allocator>::TimingWheel(uint64_t now, const Allocator& alloc) :
+	_now{now}, _alloc{alloc} {
+	for (auto& level : _slots) {
+		for (auto& slot : level) {
+			slot._prev = &slot;
+			slot._next = &slot;
+		}
+	}
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+TimingWheel<ElementType, SlotBits, Levels, Allocator>::~TimingWheel() {
+	clear();
+	while (_free) {
+		Node* next_node = static_cast<Node*>(_free->_next);
+		NodeAllocTraits::destroy(_alloc, _free);
+		NodeAllocTraits::deallocate(_alloc, _free, 1);
+		_free = next_node;
+	}
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+void TimingWheel<ElementType, SlotBits, Levels, Allocator>::link_before(NodeBase* pos, NodeBase* node) noexcept {
+	node->_prev = pos->_prev;
+	node->_next = pos;
+	pos->_prev->_next = node;
+	pos->_prev = node;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+void TimingWheel<ElementType, SlotBits, Levels, Allocator>::unlink(NodeBase* node) noexcept {
+	node->_prev->_next = node->_next;
+	node->_next->_prev = node->_prev;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+typename TimingWheel<ElementType, SlotBits, Levels, Allocator>::Node*
+TimingWheel<ElementType, SlotBits, Levels, Allocator>::acquire_node() {
+	if (_free) {
+		return std::exchange(_free, static_cast<Node*>(_free->_next));
+	}
+	Node* node = NodeAllocTraits::allocate(_alloc, 1);
+	NodeAllocTraits::construct(_alloc, node);
+	return node;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+void TimingWheel<ElementType, SlotBits, Levels, Allocator>::release_node(Node* node) noexcept {
+	std::destroy_at(&node->_val);
+	++node->_generation;
+	node->_next = _free;
+	_free = node;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+void TimingWheel<ElementType, SlotBits, Levels, Allocator>::place(Node* node) noexcept {
+	// 按距离选层，按到期时刻的对应位选槽；超出范围的按最远距离放在最高层
+	const uint64_t delta = node->_expiry - _now;
+	const uint64_t target = delta > max_delta ? _now + max_delta : node->_expiry;
+
+	uint32_t level = 0;
+	while (level + 1 < Levels && delta >= (uint64_t{1} << (SlotBits * (level + 1)))) {
+		++level;
+	}
+	const uint64_t slot = (target >> (SlotBits * level)) & slot_mask;
+	link_before(&_slots[level][slot], node);
+	mark(level, slot);
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+void TimingWheel<ElementType, SlotBits, Levels, Allocator>::cascade(uint32_t level, uint64_t slot) noexcept {
+	NodeBase& head = _slots[level][slot];
+	if (head._next == &head) {
+		return;
+	}
+
+	// 先把整条链摘下来再逐个重新放置，重新放置可能落回同一个槽
+	NodeBase* current = head._next;
+	head._prev->_next = nullptr;
+	head._prev = &head;
+	head._next = &head;
+	unmark(level, slot);
+
+	while (current) {
+		NodeBase* next_node = current->_next;
+		place(static_cast<Node*>(current));
+		current = next_node;
+	}
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+uint64_t TimingWheel<ElementType, SlotBits, Levels, Allocator>::next_occupied(uint32_t level, uint64_t from) noexcept {
+	// 从 from 开始循环向后，返回第一个非空槽的距离，没有时返回 slot_count
+	for (uint64_t scanned = 0; scanned < slot_count;) {
+		const uint64_t slot = (from + scanned) & slot_mask;
+		const uint64_t bits = _occupied[level][slot / word_bits] >> (slot % word_bits);
+		if (bits == 0) {
+			scanned += word_bits - slot % word_bits;
+			continue;
+		}
+		scanned += std::countr_zero(bits);
+		if (scanned >= slot_count) {
+			break; // 绕回到了起点之前已经查过的位置
+		}
+		const uint64_t hit = (from + scanned) & slot_mask;
+		if (_slots[level][hit]._next != &_slots[level][hit]) {
+			return scanned;
+		}
+		unmark(level, hit); // 定时器都被取消了
+		++scanned;
+	}
+	return slot_count;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+uint64_t TimingWheel<ElementType, SlotBits, Levels, Allocator>::next_event() noexcept {
+	// 第 0 层的定时器都在一圈之内；第 l 层的槽只在低位全为 0 的刻度上级联，按槽号依次轮到
+	uint64_t next = UINT64_MAX;
+	const uint64_t distance = next_occupied(0, (_now + 1) & slot_mask);
+	if (distance < slot_count) {
+		next = _now + 1 + distance;
+	}
+	for (uint32_t level = 1; level < Levels; ++level) {
+		const uint32_t shift = SlotBits * level;
+		const uint64_t boundary = ((_now >> shift) + 1) << shift;
+		const uint64_t slots = next_occupied(level, (boundary >> shift) & slot_mask);
+		if (slots < slot_count) {
+			next = std::min(next, boundary + (slots << shift));
+		}
+	}
+	return next;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+template <typename Function>
+void TimingWheel<ElementType, SlotBits, Levels, Allocator>::expire(NodeBase& slot, Function& on_expire) {
+	if (slot._next == &slot) {
+		return;
+	}
+
+	// 转移到局部哨兵上触发，回调对同一批定时器的 cancel 仍然是普通的摘链
+	NodeBase batch;
+	batch._next = slot._next;
+	batch._prev = slot._prev;
+	batch._next->_prev = &batch;
+	batch._prev->_next = &batch;
+	slot._prev = &slot;
+	slot._next = &slot;
+	unmark(0, _now & slot_mask);
+	NodeBase* outer = std::exchange(_firing, &batch);
+
+	try {
+		while (batch._next != &batch) {
+			auto node = static_cast<Node*>(batch._next);
+			ElementType val = std::move(node->_val); // 移动抛出异常时节点仍挂在 batch 上
+			unlink(node);
+			release_node(node);
+			--_size;
+			on_expire(std::move(val));
+		}
+		_firing = outer;
+	} catch (...) {
+		_firing = outer;
+		// 尚未触发的定时器不能留在局部哨兵上：接到下一刻度的槽头，下次推进时最先触发
+		if (batch._next != &batch) {
+			NodeBase& next_slot = _slots[0][(_now + 1) & slot_mask];
+			mark(0, (_now + 1) & slot_mask);
+			batch._prev->_next = next_slot._next;
+			next_slot._next->_prev = batch._prev;
+			next_slot._next = batch._next;
+			batch._next->_prev = &next_slot;
+		}
+		throw;
+	}
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+typename TimingWheel<ElementType, SlotBits, Levels, Allocator>::TimerHandle
+TimingWheel<ElementType, SlotBits, Levels, Allocator>::schedule_at(uint64_t expiry, const ElementType& val) {
+	Node* node = acquire_node();
+	try {
+		std::construct_at(&node->_val, val);
+	} catch (...) {
+		node->_next = _free;
+		_free = node;
+		throw;
+	}
+	node->_expiry = expiry > _now ? expiry : _now + 1;
+	place(node);
+	++_size;
+	return TimerHandle(node, node->_generation);
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+bool TimingWheel<ElementType, SlotBits, Levels, Allocator>::pending(const TimerHandle& handle) const noexcept {
+	return handle._node && handle._node->_generation == handle._generation;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+bool TimingWheel<ElementType, SlotBits, Levels, Allocator>::cancel(const TimerHandle& handle) noexcept {
+	if (!pending(handle)) {
+		return false;
+	}
+	unlink(handle._node);
+	release_node(handle._node);
+	--_size;
+	return true;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+template <typename Function>
+uint64_t TimingWheel<ElementType, SlotBits, Levels, Allocator>::advance(uint64_t now, Function on_expire) {
+	uint64_t expired = 0;
+	auto counted = [&](ElementType&& val) {
+		++expired;
+		on_expire(std::move(val));
+	};
+
+	while (_now < now) {
+		// 中间的刻度既没有定时器到期也没有非空槽需要级联，直接跳过
+		const uint64_t next = _size == 0 ? UINT64_MAX : next_event();
+		if (next > now) {
+			_now = now;
+			break;
+		}
+		_now = next;
+
+		// 低层每转满一圈，把上一层当前槽里的定时器分散到低层
+		for (uint32_t level = Levels - 1; level > 0; --level) {
+			const uint64_t low_bits = (uint64_t{1} << (SlotBits * level)) - 1;
+			if ((_now & low_bits) == 0) {
+				cascade(level, (_now >> (SlotBits * level)) & slot_mask);
+			}
+		}
+		expire(_slots[0][_now & slot_mask], counted);
+	}
+	return expired;
+}
+
+template <typename ElementType, uint32_t SlotBits, uint32_t Levels, typename Allocator>
+void TimingWheel<ElementType, SlotBits, Levels, Allocator>::clear() {
+	auto drain = [this](NodeBase& head) {
+		while (head._next != &head) {
+			auto node = static_cast<Node*>(head._next);
+			unlink(node);
+			release_node(node);
+		}
+	};
+	for (auto& level : _slots) {
+		for (auto& slot : level) {
+			drain(slot);
+		}
+	}
+	_occupied = {};
+	if (_firing) {
+		drain(*_firing); // 从回调中调用：本刻度尚未触发的定时器也一并释放
+	}
+	_size = 0;
+}
+}
+
+
+#endif //TIMINGWHEEL_HPP
@@ -0,0 +1,295 @@
+#ifndef XORLINKEDLIST_HPP
+#define XORLINKEDLIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace mystl {
+// 异或链表：每个节点只保存 prev ^ next 一个字，比 DoublyLinkedList 的节点少 8 字节。
+// 代价是迭代器必须同时记住前一个节点才能走下一步，因此在迭代器所指节点或其前驱
+// 附近插入、删除都会使该迭代器失效；首尾以 nullptr 结束，reverse() 只需交换首尾指针。
+template <typename ElementType, typename Allocator = std::allocator<ElementType>>
+struct XorLinkedList {
+private:
+	struct XorLinkedListNode {
+		std::uintptr_t _link = 0; // 前驱地址 ^ 后继地址
+		ElementType _val;
+
+		explicit XorLinkedListNode(const ElementType& val) : _val{val} {}
+
+		XorLinkedListNode(const XorLinkedListNode& ano_node) = delete;
+		XorLinkedListNode& operator =(const XorLinkedListNode& ano_node) = delete;
+	};
+
+public:
+	using Node = XorLinkedListNode;
+	using allocator_type = Allocator;
+
+private:
+	using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+	using NodeAllocTraits = std::allocator_traits<NodeAllocator>;
+
+	static Node* other(const Node* node, const Node* neighbour) {
+		return reinterpret_cast<Node*>(node->_link ^ reinterpret_cast<std::uintptr_t>(neighbour));
+	}
+
+	// 把 node 的链接中的 from 换成 to
+	static void relink(Node* node, const Node* from, const Node* to) {
+		node->_link ^= reinterpret_cast<std::uintptr_t>(from) ^ reinterpret_cast<std::uintptr_t>(to);
+	}
+
+	class Iterator {
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = ElementType;
+		using difference_type = std::ptrdiff_t;
+		using pointer = ElementType*;
+		using reference = ElementType&;
+
+		Node* _prev = nullptr;
+		Node* _current = nullptr;
+
+	public:
+		Iterator() = default;
+		Iterator(Node* prev, Node* current) : _prev{prev}, _current{current} {}
+
+	public:
+		ElementType& operator*() const { return _current->_val; }
+		ElementType* operator->() const { return &_current->_val; }
+
+		Iterator& operator++() {
+			Node* next_node = other(_current, _prev);
+			_prev = _current;
+			_current = next_node;
+			return *this;
+		}
+
+		Iterator& operator--() {
+			Node* prev_node = other(_prev, _current);
+			_current = _prev;
+			_prev = prev_node;
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator old = *this;
+			++*this;
+			return old;
+		}
+
+		Iterator operator--(int) {
+			Iterator old = *this;
+			--*this;
+			return old;
+		}
+
+		// 位置由 (_prev, _current) 共同确定，end() 的 _current 为空但 _prev 是尾节点
+		bool operator!=(const Iterator& ano_iter) const { return !(*this == ano_iter); }
+		bool operator==(const Iterator& ano_iter) const {
+			return _current == ano_iter._current && (_current || _prev == ano_iter._prev);
+		}
+	};
+
+public:
+	using iterator = Iterator;
+
+private:
+	uint64_t _size = 0;
+	Node* _head = nullptr;
+	Node* _tail = nullptr;
+	[[no_unique_address]] NodeAllocator _alloc;
+
+	Node* create_node(const ElementType& val);
+	void destroy_node(Node* node) noexcept;
+
+public:
+	XorLinkedList() noexcept = default;
+	explicit XorLinkedList(const Allocator& alloc) noexcept : _alloc{alloc} {}
+	XorLinkedList(std::initializer_list<ElementType> list);
+
+	XorLinkedList(const XorLinkedList& ano_list);
+	XorLinkedList& operator=(const XorLinkedList& ano_list);
+
+	XorLinkedList(XorLinkedList&& ano_list) noexcept;
+	XorLinkedList& operator=(XorLinkedList&& ano_list) noexcept;
+
+	~XorLinkedList() { clear(); }
+
+public:
+	Iterator begin() const { return Iterator(nullptr, _head); }
+	Iterator end() const { return Iterator(_tail, nullptr); }
+	ElementType& front() const { return _head->_val; }
+	ElementType& back() const { return _tail->_val; }
+	[[nodiscard]] uint64_t size() const { return _size; }
+	[[nodiscard]] bool empty() const { return _size == 0; }
+
+	void push_front(const ElementType& val) { insert(begin(), val); }
+	void push_back(const ElementType& val) { insert(end(), val); }
+	// 插到 it 之前，返回指向新元素的迭代器；it 本身随之失效
+	Iterator insert(Iterator it, const ElementType& val);
+
+	void pop_back();
+	void pop_front();
+	Iterator erase(Iterator it);
+
+	// 交换首尾即可反转整条链表，O(1)
+	void reverse() noexcept { std::swap(_head, _tail); }
+
+	void clear();
+
+	[[nodiscard]] allocator_type get_allocator() const { return allocator_type(_alloc); }
+};
+
+template <typename ElementType, typename Allocator>
+XorLinkedList<ElementType, Allocator>::XorLinkedList(std::initializer_list<ElementType> list) {
+	for (const auto& val : list) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, typename Allocator>
+XorLinkedList<ElementType, Allocator>::XorLinkedList(const XorLinkedList& ano_list) :
+	_alloc{NodeAllocTraits::select_on_container_copy_construction(ano_list._alloc)} {
+	for (const auto& val : ano_list) {
+		push_back(val);
+	}
+}
+
+template <typename ElementType, typename Allocator>
+XorLinkedList<ElementType, Allocator>& XorLinkedList<ElementType, Allocator>::operator=(const XorLinkedList& ano_list) {
+	if (this != &ano_list) {
+		clear();
+		if constexpr (NodeAllocTraits::propagate_on_container_copy_assignment::value) {
+			_alloc = ano_list._alloc;
+		}
+		for (const auto& val : ano_list) {
+			push_back(val);
+		}
+	}
+	return *this;
+}
+
+template <typename ElementType, typename Allocator>
+XorLinkedList<ElementType, Allocator>::XorLinkedList(XorLinkedList&& ano_list) noexcept :
+	_size{std::exchange(ano_list._size, 0)},
+	_head{std::exchange(ano_list._head, nullptr)},
+	_tail{std::exchange(ano_list._tail, nullptr)},
+	_alloc{std::move(ano_list._alloc)} {}
+
+template <typename ElementType, typename Allocator>
+XorLinkedList<ElementType, Allocator>& XorLinkedList<ElementType, Allocator>::operator=(XorLinkedList&& ano_list) noexcept {
+	if (this != &ano_list) {
+		clear();
+		if constexpr (NodeAllocTraits::propagate_on_container_move_assignment::value) {
+			_alloc = std::move(ano_list._alloc);
+		}
+		_size = std::exchange(ano_list._size, 0);
+		_head = std::exchange(ano_list._head, nullptr);
+		_tail = std::exchange(ano_list._tail, nullptr);
+	}
+	return *this;
+}
+
+template <typename ElementType, typename Allocator>
+typename XorLinkedList<ElementType, Allocator>::Node* XorLinkedList<ElementType, Allocator>::create_node(const ElementType& val) {
+	Node* node = NodeAllocTraits::allocate(_alloc, 1);
+	try {
+		NodeAllocTraits::construct(_alloc, node, val);
+	} catch (...) {
+		NodeAllocTraits::deallocate(_alloc, node, 1);
+		throw;
+	}
+	return node;
+}
+
+template <typename ElementType, typename Allocator>
+void XorLinkedList<ElementType, Allocator>::destroy_node(Node* node) noexcept {
+	NodeAllocTraits::destroy(_alloc, node);
+	NodeAllocTraits::deallocate(_alloc, node, 1);
+}
+
+template <typename ElementType, typename Allocator>
+typename XorLinkedList<ElementType, Allocator>::Iterator
+XorLinkedList<ElementType, Allocator>::insert(Iterator it, const ElementType& val) {
+	Node* prev_node = it._prev;
+	Node* next_node = it._current;
+	Node* new_node = create_node(val);
+	new_node->_link = reinterpret_cast<std::uintptr_t>(prev_node) ^ reinterpret_cast<std::uintptr_t>(next_node);
+
+	// 两侧邻居的链接里把对方换成新节点，链表端点时改首尾指针
+	if (prev_node) {
+		relink(prev_node, next_node, new_node);
+	} else {
+		_head = new_node;
+	}
+	if (next_node) {
+		relink(next_node, prev_node, new_node);
+	} else {
+		_tail = new_node;
+	}
+
+	++_size;
+	return Iterator(prev_node, new_node);
+}
+
+template <typename ElementType, typename Allocator>
+typename XorLinkedList<ElementType, Allocator>::Iterator XorLinkedList<ElementType, Allocator>::erase(Iterator it) {
+	Node* prev_node = it._prev;
+	Node* node = it._current;
+	Node* next_node = other(node, prev_node);
+
+	if (prev_node) {
+		relink(prev_node, node, next_node);
+	} else {
+		_head = next_node;
+	}
+	if (next_node) {
+		relink(next_node, node, prev_node);
+	} else {
+		_tail = prev_node;
+	}
+
+	destroy_node(node);
+	--_size;
+	return Iterator(prev_node, next_node);
+}
+
+template <typename ElementType, typename Allocator>
+void XorLinkedList<ElementType, Allocator>::pop_back() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	erase(Iterator(other(_tail, nullptr), _tail));
+}
+
+template <typename ElementType, typename Allocator>
+void XorLinkedList<ElementType, Allocator>::pop_front() {
+	if (empty()) {
+		throw std::out_of_range("Cannot pop from an empty list.");
+	}
+	erase(begin());
+}
+
+template <typename ElementType, typename Allocator>
+void XorLinkedList<ElementType, Allocator>::clear() {
+	Node* prev_node = nullptr;
+	Node* current = _head;
+	while (current) {
+		Node* next_node = other(current, prev_node);
+		destroy_node(current);
+		prev_node = current; // 只用作异或的地址值，不再解引用
+		current = next_node;
+	}
+	_head = nullptr;
+	_tail = nullptr;
+	_size = 0;
+}
+}
+
+
+#endif //XORLINKEDLIST_HPP
@@ -0,0 +1,117 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <sys/resource.h>
+
+#include "../AsyncQueue/AsyncQueue.hpp"
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+using namespace mystl;
+
+namespace {
+long context_switches() {
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+// 改造前的做法：互斥锁 + 条件变量包一层 DoublyLinkedList
+class LockedQueue {
+	DoublyLinkedList<uint64_t> _items;
+	std::mutex _mutex;
+	std::condition_variable _ready;
+
+public:
+	void push_back(uint64_t val) {
+		{
+			std::lock_guard lock(_mutex);
+			_items.push_back(val);
+		}
+		_ready.notify_one();
+	}
+
+	uint64_t pop() {
+		std::unique_lock lock(_mutex);
+		_ready.wait(lock, [this] { return !_items.empty(); });
+		const uint64_t val = _items.front();
+		_items.pop_front();
+		return val;
+	}
+};
+
+DetachedTask ping(AsyncQueue<uint64_t>& out, AsyncQueue<uint64_t>& in, uint64_t rounds, uint64_t& checksum) {
+	for (uint64_t i = 0; i < rounds; ++i) {
+		out.push_back(i);
+		checksum += co_await in.pop();
+	}
+}
+
+DetachedTask pong(AsyncQueue<uint64_t>& in, AsyncQueue<uint64_t>& out, uint64_t rounds) {
+	for (uint64_t i = 0; i < rounds; ++i) {
+		out.push_back(co_await in.pop() + 1);
+	}
+}
+
+void report(const char* name, double seconds, uint64_t rounds, long switches) {
+	std::printf("%-28s %9.1f ns/round trip  %10ld context switches\n", name, seconds * 1e9 / static_cast<double>(rounds),
+	            switches);
+}
+
+void coroutine_ping_pong(uint64_t rounds) {
+	CoroutineRunQueue scheduler;
+	AsyncQueue<uint64_t> to_pong(std::ref(scheduler));
+	AsyncQueue<uint64_t> to_ping(std::ref(scheduler));
+	uint64_t checksum = 0;
+
+	const long switches = context_switches();
+	const auto start = std::chrono::steady_clock::now();
+	pong(to_pong, to_ping, rounds);
+	ping(to_pong, to_ping, rounds, checksum);
+	scheduler.run();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	report("coroutines, one thread", seconds, rounds, context_switches() - switches);
+	if (checksum != rounds * (rounds + 1) / 2) {
+		std::printf("checksum mismatch\n");
+	}
+}
+
+void thread_ping_pong(uint64_t rounds) {
+	LockedQueue to_pong;
+	LockedQueue to_ping;
+
+	const long switches = context_switches();
+	const auto start = std::chrono::steady_clock::now();
+	std::thread pong_thread([&] {
+		for (uint64_t i = 0; i < rounds; ++i) {
+			to_ping.push_back(to_pong.pop() + 1);
+		}
+	});
+	uint64_t checksum = 0;
+	for (uint64_t i = 0; i < rounds; ++i) {
+		to_pong.push_back(i);
+		checksum += to_ping.pop();
+	}
+	pong_thread.join();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	report("threads, mutex + condvar", seconds, rounds, context_switches() - switches);
+	if (checksum != rounds * (rounds + 1) / 2) {
+		std::printf("checksum mismatch\n");
+	}
+}
+}
+
+// 用法：async_bench.out [往返次数]
+// 两个参与者来回传递一个计数器，每个往返包含两次 push 和两次挂起/唤醒
+int main(int argc, char** argv) {
+	const uint64_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	coroutine_ping_pong(rounds);
+	thread_ping_pong(rounds / 10); // 线程版本慢两个数量级，减少次数
+	return 0;
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "../BlockingQueue/BlockingQueue.hpp"
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+using namespace mystl;
+
+namespace {
+// 改造前的做法：互斥锁 + 两个条件变量，每次 push/pop 都 notify
+class CondvarQueue {
+	DoublyLinkedList<uint64_t> _items;
+	uint64_t _capacity;
+	std::mutex _mutex;
+	std::condition_variable _not_empty;
+	std::condition_variable _not_full;
+
+public:
+	explicit CondvarQueue(uint64_t capacity) : _capacity{capacity} {}
+
+	void push(uint64_t val) {
+		{
+			std::unique_lock lock(_mutex);
+			_not_full.wait(lock, [this] { return _items.size() < _capacity; });
+			_items.push_back(val);
+		}
+		_not_empty.notify_one();
+	}
+
+	uint64_t pop() {
+		uint64_t val;
+		{
+			std::unique_lock lock(_mutex);
+			_not_empty.wait(lock, [this] { return !_items.empty(); });
+			val = _items.front();
+			_items.pop_front();
+		}
+		_not_full.notify_one();
+		return val;
+	}
+
+	// 基线没有批量接口，逐个取
+	uint64_t pop_batch(std::span<uint64_t> out, [[maybe_unused]] uint64_t max) {
+		out[0] = pop();
+		return 1;
+	}
+};
+
+uint64_t now_ns() {
+	return static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+template <typename Queue>
+uint64_t pop_some(Queue& queue, std::span<uint64_t> out, uint64_t max) {
+	if constexpr (requires { queue.pop_batch(out, max, std::chrono::seconds(1)); }) {
+		return max == 1 ? (out[0] = queue.pop(), 1) : queue.pop_batch(out, max, std::chrono::seconds(1));
+	} else {
+		return queue.pop_batch(out, max);
+	}
+}
+
+// producers 个生产者各推入 per_producer 个元素，consumers 个消费者每次最多取 batch 个
+template <typename Queue>
+void throughput(const char* name, uint64_t producers, uint64_t consumers, uint64_t batch, uint64_t per_producer) {
+	Queue queue(1024);
+	const uint64_t total = producers * per_producer;
+	std::atomic<uint64_t> consumed = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (uint64_t p = 0; p < producers; ++p) {
+		threads.emplace_back([&queue, per_producer] {
+			for (uint64_t i = 0; i < per_producer; ++i) {
+				queue.push(i);
+			}
+		});
+	}
+	for (uint64_t c = 0; c < consumers; ++c) {
+		// 每个消费者领取固定份额，结束时不需要额外的停止信号
+		const uint64_t share = total / consumers + (c < total % consumers ? 1 : 0);
+		threads.emplace_back([&queue, &consumed, share, batch] {
+			std::vector<uint64_t> out(batch);
+			uint64_t taken = 0;
+			while (taken < share) {
+				taken += pop_some(queue, std::span<uint64_t>(out), std::min(batch, share - taken));
+			}
+			consumed += taken;
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::printf("%-22s %lluP/%lluC batch %3llu: %7.2f M items/s\n", name, static_cast<unsigned long long>(producers),
+	            static_cast<unsigned long long>(consumers), static_cast<unsigned long long>(batch),
+	            static_cast<double>(consumed.load()) / seconds / 1e6);
+}
+
+// 消费者先挂起在空队列上，生产者写入当前时间，消费者醒来后计算延迟
+template <typename Queue>
+void wakeup_latency(const char* name, uint64_t samples) {
+	Queue queue(1024);
+	std::vector<uint64_t> latencies;
+	latencies.reserve(samples);
+
+	std::thread consumer([&] {
+		uint64_t stamp;
+		for (uint64_t i = 0; i < samples; ++i) {
+			pop_some(queue, std::span<uint64_t>(&stamp, 1), 1);
+			latencies.push_back(now_ns() - stamp);
+		}
+	});
+	for (uint64_t i = 0; i < samples; ++i) {
+		std::this_thread::sleep_for(std::chrono::microseconds(200)); // 确保消费者已经越过自旋阶段挂起
+		queue.push(now_ns());
+	}
+	consumer.join();
+
+	std::sort(latencies.begin(), latencies.end());
+	std::printf("%-22s wakeup latency: p50 %6.1f us  p99 %6.1f us\n", name, latencies[samples / 2] / 1e3,
+	            latencies[samples * 99 / 100] / 1e3);
+}
+}
+
+// 用法：blocking_bench.out [每个生产者的元素个数]
+int main(int argc, char** argv) {
+	const uint64_t per_producer = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+	for (auto [producers, consumers] : {std::pair<uint64_t, uint64_t>{1, 1}, {4, 4}}) {
+		throughput<CondvarQueue>("mutex + condvar", producers, consumers, 1, per_producer);
+		throughput<BlockingQueue<uint64_t>>("BlockingQueue", producers, consumers, 1, per_producer);
+		throughput<BlockingQueue<uint64_t>>("BlockingQueue", producers, consumers, 64, per_producer);
+	}
+	wakeup_latency<CondvarQueue>("mutex + condvar", 2000);
+	wakeup_latency<BlockingQueue<uint64_t>>("BlockingQueue", 2000);
+	return 0;
+}
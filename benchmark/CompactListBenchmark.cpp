@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "../CompactDoublyLinkedList/CompactDoublyLinkedList.hpp"
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "DoNotOptimize.hpp"
+
+using namespace mystl;
+
+namespace {
+template <typename List>
+double walk_ns_per_element(const List& list, int rounds) {
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < rounds; ++round) {
+		for (auto it = list.begin(); it != list.end(); ++it) {
+			checksum += *it;
+		}
+	}
+	const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	do_not_optimize(checksum);
+	return elapsed / static_cast<double>(list.size() * rounds);
+}
+
+// 随机地从两端插入，遍历顺序与分配顺序交错，模拟长期运行后节点分散的链表
+template <typename List>
+void fill(List& list, uint64_t count, bool scattered) {
+	std::mt19937_64 rng(5);
+	for (uint64_t i = 0; i < count; ++i) {
+		if (scattered && (rng() & 1)) {
+			list.push_front(i);
+		} else {
+			list.push_back(i);
+		}
+	}
+}
+
+template <typename List>
+double measure(uint64_t count, bool scattered) {
+	List list;
+	fill(list, count, scattered);
+	return walk_ns_per_element(list, count < 1000000 ? 20 : 3);
+}
+}
+
+// 用法：compact_bench.out [元素个数]
+int main(int argc, char** argv) {
+	const uint64_t max_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16000000;
+
+	std::printf("node size: DoublyLinkedList %zu B, CompactDoublyLinkedList %zu B\n",
+	            sizeof(DoublyLinkedList<uint32_t>::Node), sizeof(CompactDoublyLinkedList<uint32_t>::Node));
+	for (uint64_t count = 1000; count <= max_count; count *= 16) {
+		for (bool scattered : {false, true}) {
+			const double pointer_ns = measure<DoublyLinkedList<uint32_t>>(count, scattered);
+			const double compact_ns = measure<CompactDoublyLinkedList<uint32_t>>(count, scattered);
+			std::printf("%9llu elements %-9s: pointer links %6.2f ns  32-bit links %6.2f ns  (%.2fx)\n",
+			            static_cast<unsigned long long>(count), scattered ? "scattered" : "in order", pointer_ns,
+			            compact_ns, pointer_ns / compact_ns);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "../CowDoublyLinkedList/CowDoublyLinkedList.hpp"
+
+using namespace mystl;
+
+// 对比深拷贝与写时复制：对同一条链表做多次只读拷贝并求和
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	const int copies = argc > 2 ? std::atoi(argv[2]) : 20;
+
+	auto elapsed_ms = [](auto start) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	DoublyLinkedList<uint64_t> deep_source;
+	for (uint64_t i = 0; i < count; ++i) {
+		deep_source.push_back(i);
+	}
+	CowDoublyLinkedList<uint64_t> cow_source(deep_source);
+
+	uint64_t checksum = 0;
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < copies; ++i) {
+			DoublyLinkedList<uint64_t> copy = deep_source;
+			checksum += copy.back();
+		}
+		std::printf("deep copy : %10.3f ms per copy\n", elapsed_ms(start) / copies);
+	}
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < copies; ++i) {
+			CowDoublyLinkedList<uint64_t> copy = cow_source;
+			checksum += copy.back();
+		}
+		std::printf("cow copy  : %10.6f ms per copy\n", elapsed_ms(start) / copies);
+	}
+	{
+		auto start = std::chrono::steady_clock::now();
+		CowDoublyLinkedList<uint64_t> copy = cow_source;
+		copy.push_back(0); // 第一次写入付出一次完整复制
+		std::printf("cow detach: %10.3f ms\n", elapsed_ms(start));
+	}
+
+	std::printf("checksum  : %llu\n", static_cast<unsigned long long>(checksum));
+	return 0;
+}
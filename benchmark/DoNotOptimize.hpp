@@ -0,0 +1,14 @@
+#ifndef DONOTOPTIMIZE_HPP
+#define DONOTOPTIMIZE_HPP
+
+namespace mystl {
+// 基准测试用：让编译器认为 value 被读取且内存可能被修改，计算 value 的循环因此不会被优化掉。
+// 空的内联汇编不产生任何指令，也不像写 volatile 变量那样多一次存储
+template <typename T>
+inline void do_not_optimize(const T& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+}
+
+
+#endif //DONOTOPTIMIZE_HPP
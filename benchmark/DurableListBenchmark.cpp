@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "../DurableList/DurableList.hpp"
+
+using namespace mystl;
+
+namespace {
+struct Task {
+	uint64_t id;
+	uint64_t deadline;
+};
+
+// 生产者/消费者交替：每推入两个任务消费一个，日志里混合了两种记录
+// 返回耗时（秒），report 为 true 时打印结果
+double run(const std::filesystem::path& directory, uint64_t sync_every, uint64_t operations, bool report) {
+	std::filesystem::remove_all(directory);
+	DurableList<Task> list(directory, DurabilityOptions{.sync_every = sync_every, .checkpoint_every = 1 << 16});
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < operations; ++i) {
+		if (i % 3 == 2) {
+			list.pop_front();
+		} else {
+			list.push_back(Task{i, i * 10});
+		}
+	}
+	list.sync();
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (report) {
+			std::printf("batch %5llu: %9.0f ops/s  %7.0f fdatasync/s  %8.2f us/op\n",
+		            static_cast<unsigned long long>(sync_every), static_cast<double>(operations) / seconds,
+		            static_cast<double>(list.sync_count()) / seconds, seconds * 1e6 / static_cast<double>(operations));
+	}
+	return seconds;
+}
+}
+
+// 用法：wal_bench.out [日志目录] [每个批次大小大约测多久，秒]
+// 目录应位于待测的本地磁盘上；tmpfs 上的 fdatasync 几乎不花时间，测不出组提交的效果
+int main(int argc, char** argv) {
+	const std::filesystem::path directory = argc > 1 ? argv[1] : "wal_bench_data";
+	const double budget = argc > 2 ? std::strtod(argv[2], nullptr) : 1.0;
+
+	for (uint64_t sync_every : {1, 4, 16, 64, 256, 1024, 4096}) {
+		// 先用少量操作估计吞吐，再按时间预算放大，避免 batch 1 在慢盘上跑上几分钟
+		uint64_t operations = 3 * sync_every * 16;
+		const double probe = run(directory / "probe", sync_every, operations, false);
+		operations = static_cast<uint64_t>(static_cast<double>(operations) * budget / std::max(probe, 1e-6));
+		operations = std::max<uint64_t>(operations / 3 * 3, 3 * sync_every);
+		run(directory / std::to_string(sync_every), sync_every, operations, true);
+	}
+	std::filesystem::remove_all(directory);
+	return 0;
+}
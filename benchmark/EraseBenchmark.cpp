@@ -0,0 +1,46 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+using namespace mystl;
+
+// 对比两种过滤方式：逐个 push_back 重建新链表 与 remove_if 原地单遍删除
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+	auto build = [count] {
+		DoublyLinkedList<uint64_t> list;
+		for (uint64_t i = 0; i < count; ++i) {
+			list.push_back(i);
+		}
+		return list;
+	};
+
+	auto elapsed_ms = [](auto start) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	{
+		auto list = build();
+		auto start = std::chrono::steady_clock::now();
+		DoublyLinkedList<uint64_t> rebuilt;
+		for (auto it = list.begin(); it != list.end(); ++it) {
+			if (*it % 2 == 1) {
+				rebuilt.push_back(*it);
+			}
+		}
+		list = std::move(rebuilt);
+		std::printf("rebuild   : %10.2f ms, %llu left\n", elapsed_ms(start), static_cast<unsigned long long>(list.size()));
+	}
+
+	{
+		auto list = build();
+		auto start = std::chrono::steady_clock::now();
+		erase_if(list, [](uint64_t x) { return x % 2 == 0; });
+		std::printf("erase_if  : %10.2f ms, %llu left\n", elapsed_ms(start), static_cast<unsigned long long>(list.size()));
+	}
+
+	return 0;
+}
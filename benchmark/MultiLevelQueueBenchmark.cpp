@@ -0,0 +1,122 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../MultiLevelQueue/MultiLevelQueue.hpp"
+#include "DoNotOptimize.hpp"
+
+using namespace mystl;
+
+namespace {
+constexpr uint32_t levels = 64;
+
+// 改造前的做法：每级一条 DoublyLinkedList，从第 0 级线性扫描找第一个非空级
+class ScanQueue {
+	using List = DoublyLinkedList<uint32_t>;
+
+	std::array<List, levels> _levels;
+
+public:
+	struct Handle {
+		List::iterator _it;
+		uint32_t _level = 0;
+	};
+
+	Handle push(uint32_t val, uint32_t level) {
+		_levels[level].push_back(val);
+		auto it = _levels[level].end();
+		--it;
+		return Handle{it, level};
+	}
+
+	uint32_t pop() {
+		for (auto& list : _levels) {
+			if (!list.empty()) {
+				const uint32_t val = list.front();
+				list.pop_front();
+				return val;
+			}
+		}
+		throw std::out_of_range("Cannot pop from an empty queue.");
+	}
+
+	void move(Handle& handle, uint32_t level) {
+		auto node = _levels[handle._level].extract(handle._it);
+		handle._it = _levels[level].insert(_levels[level].end(), std::move(node));
+		handle._level = level;
+	}
+};
+
+// 模拟多级反馈调度：每个刻度取出优先级最高的任务运行，
+// 用满时间片的降一级，其余的进入阻塞，阻塞任务随机被唤醒后回到较高的级；
+// 另外随机地对就绪任务调整优先级（renice），走按句柄移动的路径
+template <typename Queue>
+double ns_per_tick(uint32_t tasks, uint64_t ticks) {
+	Queue queue;
+	std::vector<typename Queue::Handle> handles(tasks);
+	std::vector<uint32_t> level_of(tasks);
+	std::vector<uint8_t> runnable(tasks, 1);
+	std::vector<uint32_t> blocked;
+	std::mt19937 rng(47);
+
+	for (uint32_t task = 0; task < tasks; ++task) {
+		level_of[task] = task % 8 + levels / 2; // 初始都在中低优先级
+		handles[task] = queue.push(task, level_of[task]);
+	}
+
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t tick = 0; tick < ticks; ++tick) {
+		const uint32_t task = queue.pop();
+		checksum += task;
+		const uint32_t roll = rng();
+		if (roll % 4 != 0) {
+			level_of[task] = std::min(level_of[task] + 1, levels - 1);
+			handles[task] = queue.push(task, level_of[task]);
+		} else {
+			runnable[task] = 0;
+			blocked.push_back(task);
+		}
+
+		// 唤醒：I/O 完成的任务提升两级
+		if (!blocked.empty() && (roll >> 8) % 3 != 0) {
+			const uint32_t index = (roll >> 12) % blocked.size();
+			const uint32_t woken = blocked[index];
+			blocked[index] = blocked.back();
+			blocked.pop_back();
+			level_of[woken] = level_of[woken] >= 2 ? level_of[woken] - 2 : 0;
+			runnable[woken] = 1;
+			handles[woken] = queue.push(woken, level_of[woken]);
+		}
+
+		// renice 一个仍在就绪队列中的任务
+		const uint32_t victim = (roll >> 20) % tasks;
+		if (runnable[victim] && (roll & 0xf0) == 0) {
+			level_of[victim] = rng() % levels;
+			queue.move(handles[victim], level_of[victim]);
+		}
+	}
+	const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	do_not_optimize(checksum);
+	return elapsed / static_cast<double>(ticks);
+}
+}
+
+// 用法：mlq_bench.out [刻度数]
+int main(int argc, char** argv) {
+	const uint64_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+	for (uint32_t tasks : {16, 256, 4096}) {
+		const double scan_ns = ns_per_tick<ScanQueue>(tasks, ticks);
+		const double bitmap_ns = ns_per_tick<MultiLevelQueue<uint32_t, levels>>(tasks, ticks);
+		std::printf("%5u tasks, %u levels: linear scan %6.1f ns/tick  bitmap %6.1f ns/tick  (%.2fx)\n", tasks, levels,
+		            scan_ns, bitmap_ns, scan_ns / bitmap_ns);
+	}
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../NodeArena/NodeArena.hpp"
+#include "DoNotOptimize.hpp"
+
+using namespace mystl;
+
+namespace {
+// 读取 /sys 下每个 NUMA 节点的第一个 CPU，用于把遍历线程固定到本地或远端节点
+std::vector<std::pair<int, int>> numa_first_cpus() {
+	std::vector<std::pair<int, int>> result;
+	for (int node = 0; node < 64; ++node) {
+		std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+		int cpu = -1;
+		if (cpulist >> cpu) {
+			result.emplace_back(node, cpu);
+		}
+	}
+	return result;
+}
+
+bool pin_to_cpu(int cpu) {
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	(void)cpu;
+	return false;
+#endif
+}
+
+// 构造一条节点地址被打乱的链表，使遍历对 TLB 和缓存都不友好
+template <typename List>
+void fill_shuffled(List& list, uint64_t count, std::mt19937_64& rng) {
+	for (uint64_t i = 0; i < count; ++i) {
+		list.push_back(i);
+	}
+	std::vector<typename List::node_type> handles;
+	handles.reserve(count);
+	while (!list.empty()) {
+		handles.push_back(list.extract(list.begin()));
+	}
+	std::shuffle(handles.begin(), handles.end(), rng);
+	for (auto& handle : handles) {
+		list.insert(list.end(), std::move(handle));
+	}
+}
+
+template <typename List>
+double walk_ns_per_element(const List& list) {
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		checksum += *it;
+	}
+	const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	do_not_optimize(checksum); // 防止遍历被优化掉
+	return elapsed / static_cast<double>(list.size());
+}
+
+const char* policy_name(HugePagePolicy policy) {
+	switch (policy) {
+	case HugePagePolicy::None:
+		return "arena 4K pages";
+	case HugePagePolicy::Transparent:
+		return "arena THP";
+	case HugePagePolicy::Explicit:
+		return "arena MAP_HUGETLB";
+	}
+	return "";
+}
+}
+
+// 用法：numa_bench.out [元素个数]
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+	std::mt19937_64 rng(7);
+
+	// 第一部分：不同页策略下的遍历开销
+	{
+		DoublyLinkedList<uint64_t> list;
+		fill_shuffled(list, count, rng);
+		std::printf("%-20s: %8.2f ns/element\n", "malloc", walk_ns_per_element(list));
+	}
+	for (auto policy : {HugePagePolicy::None, HugePagePolicy::Transparent, HugePagePolicy::Explicit}) {
+		NodeArena arena(ArenaOptions{.chunk_bytes = std::size_t{64} << 20, .huge_pages = policy});
+		DoublyLinkedList<uint64_t, ArenaAllocator<uint64_t>> list{ArenaAllocator<uint64_t>(arena)};
+		fill_shuffled(list, count, rng);
+		const char* huge_pages = arena.huge_pages_active()      ? "active"
+		                         : arena.huge_pages_requested() ? "requested, not backed"
+		                                                        : "unavailable";
+		std::printf("%-20s: %8.2f ns/element (huge pages %s)\n", policy_name(policy), walk_ns_per_element(list),
+		            huge_pages);
+	}
+
+	// 第二部分：节点绑定在 NUMA 节点 0，分别从本地和远端节点的 CPU 遍历
+	const auto nodes = numa_first_cpus();
+	if (nodes.size() < 2) {
+		std::printf("local/remote: only %zu NUMA node(s) visible, comparison skipped\n", nodes.size());
+		return 0;
+	}
+
+	const auto [local_node, local_cpu] = nodes.front();
+	const auto [remote_node, remote_cpu] = nodes.back();
+
+	pin_to_cpu(local_cpu);
+	NodeArena arena(ArenaOptions{.chunk_bytes = std::size_t{64} << 20, .numa_node = local_node});
+	DoublyLinkedList<uint64_t, ArenaAllocator<uint64_t>> list{ArenaAllocator<uint64_t>(arena)};
+	fill_shuffled(list, count, rng);
+	if (!arena.numa_bound()) {
+		std::printf("local/remote: mbind unavailable, placement follows first touch\n");
+	}
+
+	const double local = walk_ns_per_element(list);
+	pin_to_cpu(remote_cpu);
+	const double remote = walk_ns_per_element(list);
+
+	std::printf("local  (node %d, cpu %d): %8.2f ns/element\n", local_node, local_cpu, local);
+	std::printf("remote (node %d, cpu %d): %8.2f ns/element\n", remote_node, remote_cpu, remote);
+	return 0;
+}
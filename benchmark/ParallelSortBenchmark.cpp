@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <execution>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../NodeArena/NodeArena.hpp"
+
+using namespace mystl;
+
+namespace {
+using List = DoublyLinkedList<uint64_t, ArenaAllocator<uint64_t>>;
+
+std::vector<uint64_t> random_values(uint64_t count) {
+	std::mt19937_64 rng(48);
+	std::vector<uint64_t> values(count);
+	for (auto& val : values) {
+		val = rng();
+	}
+	return values;
+}
+
+bool is_sorted(List& list) {
+	uint64_t previous = 0;
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		if (*it < previous) {
+			return false;
+		}
+		previous = *it;
+	}
+	return true;
+}
+
+// 每次都从同一份随机数据在新的 arena 上重新建表，节点的内存布局完全相同，
+// 不受上一轮释放顺序的影响；只计 op 本身的时间，结束后用 check 校验结果
+template <typename Op, typename Check>
+double ms_per_run(const std::vector<uint64_t>& values, Op op, Check check) {
+	NodeArena arena;
+	List list{ArenaAllocator<uint64_t>(arena)};
+	list.push_back_batch(values);
+	const auto start = std::chrono::steady_clock::now();
+	op(list);
+	const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	if (!check(list)) {
+		std::fprintf(stderr, "unexpected result\n");
+		std::exit(1);
+	}
+	return elapsed;
+}
+}
+
+// 用法：psort_bench.out [最大线程数] [元素个数]
+int main(int argc, char** argv) {
+	const uint32_t max_threads = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10))
+	                                      : std::max(1u, std::thread::hardware_concurrency());
+	const uint64_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4000000;
+	const auto values = random_values(count);
+
+	const double sequential = ms_per_run(values, [](auto& list) { list.sort(); }, is_sorted);
+	std::printf("%llu elements, sort                  : %8.1f ms\n", static_cast<unsigned long long>(count), sequential);
+	for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+		const double parallel = ms_per_run(
+			values, [threads](auto& list) { list.sort(std::execution::par, std::less<>(), threads); }, is_sorted);
+		std::printf("%llu elements, sort(par) %3u threads : %8.1f ms  (%.2fx)\n", static_cast<unsigned long long>(count),
+		            threads, parallel, sequential / parallel);
+	}
+
+	const auto below_half = [](uint64_t val) { return val < UINT64_MAX / 2; };
+	const auto partitioned = [&below_half](auto& list) {
+		auto it = list.begin();
+		while (it != list.end() && below_half(*it)) {
+			++it;
+		}
+		while (it != list.end() && !below_half(*it)) {
+			++it;
+		}
+		return it == list.end();
+	};
+	const double partition = ms_per_run(values, [&](auto& list) { list.stable_partition(below_half); }, partitioned);
+	std::printf("%llu elements, stable_partition      : %8.1f ms\n", static_cast<unsigned long long>(count), partition);
+	for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+		const double parallel = ms_per_run(
+			values, [&, threads](auto& list) { list.stable_partition(std::execution::par, below_half, threads); },
+			partitioned);
+		std::printf("%llu elements, stable_partition(par) %3u threads: %8.1f ms  (%.2fx)\n",
+		            static_cast<unsigned long long>(count), threads, parallel, partition / parallel);
+	}
+	return 0;
+}
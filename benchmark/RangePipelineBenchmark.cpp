@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ranges>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+using namespace mystl;
+
+namespace {
+using List = DoublyLinkedList<uint64_t>;
+
+// 手写的指针遍历：从哨兵沿 _prev 走回来，对偶数元素乘 3 后求和
+uint64_t pointer_walk(const List& list) {
+	const auto* sentinel = list.end()._current;
+	uint64_t sum = 0;
+	for (const auto* node = sentinel->_prev; node != sentinel; node = node->_prev) {
+		const uint64_t val = static_cast<const List::Node*>(node)->_val;
+		if (val % 2 == 0) {
+			sum += val * 3;
+		}
+	}
+	return sum;
+}
+
+// 同样的计算写成 rbegin/rend 循环
+uint64_t reverse_loop(const List& list) {
+	uint64_t sum = 0;
+	for (auto it = list.rbegin(); it != list.rend(); ++it) {
+		if (*it % 2 == 0) {
+			sum += *it * 3;
+		}
+	}
+	return sum;
+}
+
+// 同样的计算写成视图管道
+uint64_t range_pipeline(const List& list) {
+	uint64_t sum = 0;
+	for (uint64_t val : list | std::views::reverse | std::views::filter([](uint64_t val) { return val % 2 == 0; }) |
+	                        std::views::transform([](uint64_t val) { return val * 3; })) {
+		sum += val;
+	}
+	return sum;
+}
+
+template <typename Walk>
+double ns_per_element(const char* name, const List& list, uint64_t rounds, Walk walk) {
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t round = 0; round < rounds; ++round) {
+		checksum += walk(list);
+	}
+	const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	const double per_element = elapsed / static_cast<double>(rounds * list.size());
+	std::printf("%-40s %6.3f ns/element  (checksum %llu)\n", name, per_element, static_cast<unsigned long long>(checksum));
+	return per_element;
+}
+}
+
+// 用法：range_bench.out [元素个数] [轮数]
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+	const uint64_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+
+	List list;
+	for (uint64_t i = 0; i < count; ++i) {
+		list.push_back(i);
+	}
+	const double raw = ns_per_element("pointer walk over _prev", list, rounds, pointer_walk);
+	const double loop = ns_per_element("rbegin/rend loop", list, rounds, reverse_loop);
+	const double pipeline = ns_per_element("reverse | filter | transform", list, rounds, range_pipeline);
+	std::printf("overhead vs pointer walk: loop %.2fx, pipeline %.2fx\n", loop / raw, pipeline / raw);
+	return 0;
+}
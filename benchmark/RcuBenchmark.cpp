@@ -0,0 +1,109 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../RcuList/RcuList.hpp"
+#include "DoNotOptimize.hpp"
+
+using namespace mystl;
+
+namespace {
+constexpr uint64_t list_length = 1000;
+
+// 读者反复完整遍历、写者不停 push_back + pop_front，统计固定时长内读者的遍历次数和写者的操作次数
+template <typename Setup, typename Read, typename Write>
+void run(const char* name, int readers, std::chrono::milliseconds duration, Setup setup, Read read, Write write) {
+	setup();
+	std::atomic<bool> stop{false};
+	std::atomic<uint64_t> traversals{0};
+	uint64_t writes = 0;
+
+	std::vector<std::thread> threads;
+	for (int r = 0; r < readers; ++r) {
+		threads.emplace_back([&] {
+			uint64_t local = 0;
+			uint64_t checksum = 0;
+			while (!stop.load(std::memory_order_relaxed)) {
+				checksum += read();
+				++local;
+			}
+			traversals.fetch_add(local);
+			do_not_optimize(checksum);
+		});
+	}
+
+	const auto deadline = std::chrono::steady_clock::now() + duration;
+	while (std::chrono::steady_clock::now() < deadline) {
+		for (int i = 0; i < 64; ++i) {
+			write(writes++);
+		}
+	}
+	stop.store(true);
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	const double seconds = std::chrono::duration<double>(duration).count();
+	std::printf("%-14s readers=%2d  traversals/s=%12.0f  writes/s=%12.0f\n", name, readers,
+	            static_cast<double>(traversals.load()) / seconds, static_cast<double>(writes) / seconds);
+}
+}
+
+// 用法：rcu_bench.out [最大读者线程数] [每组时长毫秒]
+int main(int argc, char** argv) {
+	const int max_readers = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+	const auto duration = std::chrono::milliseconds(argc > 2 ? std::atoi(argv[2]) : 500);
+
+	for (int readers = 1; readers <= std::max(1, max_readers); readers *= 2) {
+		{
+			DoublyLinkedList<uint64_t> list;
+			std::shared_mutex mutex;
+			run("shared_mutex", readers, duration,
+			    [&] {
+				    for (uint64_t i = 0; i < list_length; ++i) {
+					    list.push_back(i);
+				    }
+			    },
+			    [&] {
+				    std::shared_lock lock(mutex);
+				    uint64_t sum = 0;
+				    for (auto it = list.begin(); it != list.end(); ++it) {
+					    sum += *it;
+				    }
+				    return sum;
+			    },
+			    [&](uint64_t i) {
+				    std::unique_lock lock(mutex);
+				    list.push_back(i);
+				    list.pop_front();
+			    });
+		}
+		{
+			EpochDomain domain;
+			RcuList<uint64_t> list(domain);
+			run("rcu", readers, duration,
+			    [&] {
+				    for (uint64_t i = 0; i < list_length; ++i) {
+					    list.push_back(i);
+				    }
+			    },
+			    [&] {
+				    uint64_t sum = 0;
+				    list.for_each([&sum](uint64_t value) { sum += value; });
+				    return sum;
+			    },
+			    [&](uint64_t i) {
+				    list.push_back(i);
+				    list.pop_front();
+			    });
+			domain.synchronize();
+		}
+	}
+	return 0;
+}
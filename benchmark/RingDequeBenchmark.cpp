@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../RingDeque/RingDeque.hpp"
+#include "DoNotOptimize.hpp"
+
+using namespace mystl;
+
+namespace {
+// 稳态队列：保持 depth 个元素，每次入队一个、出队一个
+template <typename Queue>
+double steady_ns_per_op(Queue& queue, uint64_t depth, uint64_t operations) {
+	for (uint64_t i = 0; i < depth; ++i) {
+		queue.push_back(i);
+	}
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < operations; ++i) {
+		queue.push_back(i);
+		checksum += queue.front();
+		queue.pop_front();
+	}
+	const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	do_not_optimize(checksum);
+	return elapsed / static_cast<double>(operations);
+}
+
+// 突发队列：一次入队 burst 个，再全部出队
+template <typename Queue>
+double burst_ns_per_op(Queue& queue, uint64_t burst, uint64_t operations) {
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t done = 0; done < operations; done += burst) {
+		for (uint64_t i = 0; i < burst; ++i) {
+			queue.push_back(i);
+		}
+		while (!queue.empty()) {
+			checksum += queue.front();
+			queue.pop_front();
+		}
+	}
+	const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	do_not_optimize(checksum);
+	return elapsed / static_cast<double>(operations);
+}
+}
+
+// 用法：ring_bench.out [操作次数]
+int main(int argc, char** argv) {
+	const uint64_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+
+	for (uint64_t depth : {16, 1024, 65536}) {
+		DoublyLinkedList<uint64_t> list;
+		RingDeque<uint64_t> ring;
+		const double list_ns = steady_ns_per_op(list, depth, operations);
+		const double ring_ns = steady_ns_per_op(ring, depth, operations);
+		std::printf("steady depth %-6llu: list %6.2f ns/op  ring %6.2f ns/op  speedup %5.2fx\n",
+		            static_cast<unsigned long long>(depth), list_ns, ring_ns, list_ns / ring_ns);
+	}
+
+	for (uint64_t burst : {64, 1024}) {
+		DoublyLinkedList<uint64_t> list;
+		RingDeque<uint64_t, OverflowPolicy::Fail> ring(burst);
+		const double list_ns = burst_ns_per_op(list, burst, operations);
+		const double ring_ns = burst_ns_per_op(ring, burst, operations);
+		std::printf("burst  size  %-6llu: list %6.2f ns/op  ring %6.2f ns/op  speedup %5.2fx\n",
+		            static_cast<unsigned long long>(burst), list_ns, ring_ns, list_ns / ring_ns);
+	}
+	return 0;
+}
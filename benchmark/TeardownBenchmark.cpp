@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../NodeArena/NodeArena.hpp"
+
+using namespace mystl;
+
+namespace {
+enum class Release {
+	Malloc,     // std::allocator，逐个 free
+	ArenaEach,  // 区域里还有别的块，clear 逐个归还到空闲链表
+	ArenaBulk,  // 区域里只有本链表的节点，clear 整体重置区域
+};
+
+const char* release_name(Release release) {
+	switch (release) {
+	case Release::Malloc: return "std::allocator";
+	case Release::ArenaEach: return "arena, per node";
+	default: return "arena, bulk";
+	}
+}
+
+template <typename T>
+T make_value(uint64_t key) {
+	if constexpr (std::is_same_v<T, std::string>) {
+		return std::string(32, static_cast<char>('a' + key % 26)); // 超过 SSO 长度，析构时要释放堆内存
+	} else {
+		return key;
+	}
+}
+
+// 节点地址的一个双射打散，按它排序后链表顺序与内存顺序无关
+uint64_t scramble(const void* address) {
+	return (reinterpret_cast<uintptr_t>(address) >> 4) * 0x9e3779b97f4a7c15ULL;
+}
+
+// 建一条 count 个节点的链表，shuffled 时打乱节点顺序（sort 只重新链接、不移动元素）；只计 clear 的时间
+template <typename T, typename List>
+double ms_to_clear(List& list, uint64_t count, bool shuffled) {
+	for (uint64_t i = 0; i < count; ++i) {
+		list.push_back(make_value<T>(i));
+	}
+	if (shuffled) {
+		list.sort([](const T& a, const T& b) { return scramble(&a) < scramble(&b); });
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	list.clear();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+double ms_to_clear(Release release, uint64_t count, bool shuffled) {
+	if (release == Release::Malloc) {
+		DoublyLinkedList<T> list;
+		return ms_to_clear<T>(list, count, shuffled);
+	}
+	NodeArena arena;
+	DoublyLinkedList<T, ArenaAllocator<T>> list{ArenaAllocator<T>(arena)};
+	DoublyLinkedList<T, ArenaAllocator<T>> other{ArenaAllocator<T>(arena)};
+	if (release == Release::ArenaEach) {
+		other.push_back(make_value<T>(0)); // 共用区域的另一条链表让整块释放不成立
+	}
+	return ms_to_clear<T>(list, count, shuffled);
+}
+
+// 同一条链表反复填满再清空，clear 保留区域的块，之后的填充不再向系统申请内存
+template <typename T>
+double ms_per_cycle(Release release, uint64_t count, uint64_t cycles) {
+	NodeArena arena;
+	DoublyLinkedList<T> heap_list;
+	DoublyLinkedList<T, ArenaAllocator<T>> arena_list{ArenaAllocator<T>(arena)};
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t cycle = 0; cycle < cycles; ++cycle) {
+		for (uint64_t i = 0; i < count; ++i) {
+			if (release == Release::Malloc) {
+				heap_list.push_back(make_value<T>(i));
+			} else {
+				arena_list.push_back(make_value<T>(i));
+			}
+		}
+		heap_list.clear();
+		arena_list.clear();
+	}
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / cycles;
+}
+
+template <typename T>
+void report(const char* type_name, uint64_t count) {
+	for (bool shuffled : {false, true}) {
+		for (Release release : {Release::Malloc, Release::ArenaEach, Release::ArenaBulk}) {
+			std::printf("%-12s %-8s %-16s: %9.2f ms  (%llu nodes)\n", type_name, shuffled ? "shuffled" : "in order",
+			            release_name(release), ms_to_clear<T>(release, count, shuffled),
+			            static_cast<unsigned long long>(count));
+		}
+	}
+}
+}
+
+// 用法：teardown_bench.out [节点数]
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	report<uint64_t>("uint64_t", count);
+	report<std::string>("std::string", count / 4);
+	for (Release release : {Release::Malloc, Release::ArenaBulk}) {
+		std::printf("%-12s %-8s %-16s: %9.4f ms  (push/clear cycle of 64 nodes)\n", "uint64_t", "refill",
+		            release_name(release), ms_per_cycle<uint64_t>(release, 64, 100000));
+	}
+	return 0;
+}
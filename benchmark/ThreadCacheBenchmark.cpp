@@ -0,0 +1,96 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../ThreadCacheAllocator/ThreadCacheAllocator.hpp"
+
+using namespace mystl;
+
+namespace {
+// 生产者 push_back、消费者 pop_front，链表由互斥锁保护：节点总是在一个线程分配、在另一个线程释放
+template <typename Allocator>
+double cross_thread_mops(uint64_t count) {
+	DoublyLinkedList<uint64_t, Allocator> list;
+	std::mutex mutex;
+
+	const auto start = std::chrono::steady_clock::now();
+	std::thread producer([&] {
+		for (uint64_t i = 0; i < count; ++i) {
+			std::lock_guard lock(mutex);
+			list.push_back(i);
+		}
+	});
+	std::thread consumer([&] {
+		uint64_t consumed = 0;
+		while (consumed < count) {
+			std::lock_guard lock(mutex);
+			while (!list.empty()) {
+				list.pop_front();
+				++consumed;
+			}
+		}
+	});
+	producer.join();
+	consumer.join();
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return static_cast<double>(count) / seconds / 1e6;
+}
+
+// 只测分配器本身：一个线程分配，另一个线程释放，中间用无锁单生产者单消费者环形队列传递
+template <typename Allocator>
+double raw_allocation_mops(uint64_t count) {
+	using T = typename Allocator::value_type;
+	constexpr uint64_t capacity = 1024;
+	T* ring[capacity];
+	std::atomic<uint64_t> head{0};
+	std::atomic<uint64_t> tail{0};
+
+	const auto start = std::chrono::steady_clock::now();
+	std::thread producer([&] {
+		Allocator alloc;
+		for (uint64_t i = 0; i < count; ++i) {
+			while (tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) == capacity) {
+				std::this_thread::yield();
+			}
+			ring[tail.load(std::memory_order_relaxed) % capacity] = alloc.allocate(1);
+			tail.fetch_add(1, std::memory_order_release);
+		}
+	});
+	std::thread consumer([&] {
+		Allocator alloc;
+		for (uint64_t i = 0; i < count; ++i) {
+			while (head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire)) {
+				std::this_thread::yield();
+			}
+			alloc.deallocate(ring[head.load(std::memory_order_relaxed) % capacity], 1);
+			head.fetch_add(1, std::memory_order_release);
+		}
+	});
+	producer.join();
+	consumer.join();
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return static_cast<double>(count) / seconds / 1e6;
+}
+
+struct alignas(8) NodeSized {
+	char bytes[24];
+};
+}
+
+// 用法：thread_cache_bench.out [操作次数]
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+	std::printf("list  std::allocator       : %8.2f Mops/s\n", cross_thread_mops<std::allocator<uint64_t>>(count));
+	std::printf("list  ThreadCacheAllocator : %8.2f Mops/s\n", cross_thread_mops<ThreadCacheAllocator<uint64_t>>(count));
+	std::printf("alloc std::allocator       : %8.2f Mops/s\n", raw_allocation_mops<std::allocator<NodeSized>>(count));
+	std::printf("alloc ThreadCacheAllocator : %8.2f Mops/s\n", raw_allocation_mops<ThreadCacheAllocator<NodeSized>>(count));
+	return 0;
+}
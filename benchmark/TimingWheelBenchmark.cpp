@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../TimingWheel/TimingWheel.hpp"
+#include "DoNotOptimize.hpp"
+
+using namespace mystl;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double ns_per_op(Clock::time_point start, uint64_t ops) {
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(ops);
+}
+
+void report(const char* name, double schedule_ns, double cancel_ns, double expire_ns, uint64_t fired) {
+	std::printf("%-16s schedule %7.1f ns  cancel %7.1f ns  expire %7.1f ns/timer  (fired %llu)\n", name,
+	            schedule_ns, cancel_ns, expire_ns, static_cast<unsigned long long>(fired));
+}
+
+// 典型的超时用法：大部分定时器在到期前被取消
+void bench_wheel(const std::vector<uint64_t>& expiries, uint64_t horizon) {
+	TimingWheel<uint64_t> wheel;
+	std::vector<TimingWheel<uint64_t>::timer_handle> handles;
+	handles.reserve(expiries.size());
+
+	auto start = Clock::now();
+	for (uint64_t i = 0; i < expiries.size(); ++i) {
+		handles.push_back(wheel.schedule_at(expiries[i], i));
+	}
+	const double schedule_ns = ns_per_op(start, expiries.size());
+
+	start = Clock::now();
+	uint64_t cancelled = 0;
+	for (uint64_t i = 0; i < handles.size(); i += 2) {
+		cancelled += wheel.cancel(handles[i]);
+	}
+	const double cancel_ns = ns_per_op(start, cancelled);
+
+	start = Clock::now();
+	uint64_t checksum = 0;
+	uint64_t fired = 0;
+	for (uint64_t now = 1; now <= horizon; ++now) {
+		fired += wheel.advance(now, [&](uint64_t id) { checksum += id; });
+	}
+	const double expire_ns = ns_per_op(start, fired);
+
+	do_not_optimize(checksum);
+	report("timing wheel", schedule_ns, cancel_ns, expire_ns, fired);
+}
+
+// 堆不支持按句柄删除，只能标记取消、出堆时跳过
+void bench_heap(const std::vector<uint64_t>& expiries, uint64_t horizon) {
+	using Entry = std::pair<uint64_t, uint64_t>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+	std::vector<bool> cancelled_flags(expiries.size(), false);
+
+	auto start = Clock::now();
+	for (uint64_t i = 0; i < expiries.size(); ++i) {
+		heap.emplace(expiries[i], i);
+	}
+	const double schedule_ns = ns_per_op(start, expiries.size());
+
+	start = Clock::now();
+	uint64_t cancelled = 0;
+	for (uint64_t i = 0; i < expiries.size(); i += 2) {
+		cancelled_flags[i] = true;
+		++cancelled;
+	}
+	const double cancel_ns = ns_per_op(start, cancelled);
+
+	start = Clock::now();
+	uint64_t checksum = 0;
+	uint64_t fired = 0;
+	for (uint64_t now = 1; now <= horizon; ++now) {
+		while (!heap.empty() && heap.top().first <= now) {
+			const uint64_t id = heap.top().second;
+			heap.pop();
+			if (!cancelled_flags[id]) {
+				checksum += id;
+				++fired;
+			}
+		}
+	}
+	const double expire_ns = ns_per_op(start, fired);
+
+	do_not_optimize(checksum);
+	report("priority_queue", schedule_ns, cancel_ns, expire_ns, fired);
+}
+}
+
+// 用法：timer_bench.out [定时器个数] [最大延迟刻度]
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	const uint64_t horizon = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : uint64_t{1} << 20;
+
+	std::mt19937_64 rng(11);
+	std::vector<uint64_t> expiries(count);
+	for (auto& expiry : expiries) {
+		expiry = 1 + rng() % horizon;
+	}
+
+	bench_wheel(expiries, horizon);
+	bench_heap(expiries, horizon);
+	return 0;
+}
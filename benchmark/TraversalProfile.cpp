@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+
+using namespace mystl;
+
+namespace {
+using List = DoublyLinkedList<uint64_t>;
+
+// 时间戳：x86 上用 rdtsc（前后加 lfence 防止乱序），其他平台退化为纳秒
+inline uint64_t timestamp() {
+#if defined(__x86_64__) || defined(__i386__)
+	_mm_lfence();
+	const uint64_t tsc = __rdtsc();
+	_mm_lfence();
+	return tsc;
+#else
+	return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+constexpr const char* timestamp_unit() {
+#if defined(__x86_64__) || defined(__i386__)
+	return "cycles";
+#else
+	return "ns";
+#endif
+}
+
+// 按 perf_event 读取一个硬件缓存事件，内核不允许时 valid() 为 false
+class PerfCounter {
+public:
+	enum class Event { LlcReadMiss, DtlbReadMiss };
+
+	explicit PerfCounter(Event event) {
+#ifdef __linux__
+		const uint64_t cache = event == Event::LlcReadMiss ? PERF_COUNT_HW_CACHE_LL : PERF_COUNT_HW_CACHE_DTLB;
+		perf_event_attr attr{};
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.size = sizeof(attr);
+		attr.config = cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+		(void)event;
+#endif
+	}
+
+	PerfCounter(const PerfCounter&) = delete;
+	PerfCounter& operator=(const PerfCounter&) = delete;
+
+	~PerfCounter() {
+#ifdef __linux__
+		if (_fd >= 0) {
+			close(_fd);
+		}
+#endif
+	}
+
+	[[nodiscard]] bool valid() const { return _fd >= 0; }
+
+	void start() {
+#ifdef __linux__
+		if (valid()) {
+			ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	uint64_t stop() {
+		uint64_t value = 0;
+#ifdef __linux__
+		if (valid()) {
+			ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(_fd, &value, sizeof(value)) != sizeof(value)) {
+				value = 0;
+			}
+		}
+#endif
+		return value;
+	}
+
+private:
+	int _fd = -1;
+};
+
+// 以 2 的幂为桶的延迟直方图
+struct Histogram {
+	static constexpr int bucket_count = 24;
+	std::array<uint64_t, bucket_count> buckets{};
+
+	void add(uint64_t value) {
+		int bucket = 0;
+		while (value > 1 && bucket < bucket_count - 1) {
+			value >>= 1;
+			++bucket;
+		}
+		++buckets[bucket];
+	}
+
+	void print(uint64_t total) const {
+		for (int i = 0; i < bucket_count; ++i) {
+			if (buckets[i] == 0) {
+				continue;
+			}
+			const double percent = 100.0 * static_cast<double>(buckets[i]) / static_cast<double>(total);
+			std::printf("    [%8llu, %8llu) %6.2f%% ", 1ULL << i, 1ULL << (i + 1), percent);
+			for (int bar = 0; bar < static_cast<int>(percent / 2); ++bar) {
+				std::putchar('#');
+			}
+			std::putchar('\n');
+		}
+	}
+};
+
+// 顺序：节点按链表顺序依次分配，地址大体连续
+List build_sequential(uint64_t count) {
+	List list;
+	for (uint64_t i = 0; i < count; ++i) {
+		list.push_back(i);
+	}
+	return list;
+}
+
+// 乱序：先顺序分配，再把节点摘下打乱后重新链入，链表顺序与地址顺序无关
+List build_shuffled(uint64_t count, std::mt19937_64& rng) {
+	List list = build_sequential(count);
+	std::vector<List::node_type> handles;
+	handles.reserve(count);
+	while (!list.empty()) {
+		handles.push_back(list.extract(list.begin()));
+	}
+	std::shuffle(handles.begin(), handles.end(), rng);
+	for (auto& handle : handles) {
+		list.insert(list.end(), std::move(handle));
+	}
+	return list;
+}
+
+// 反复增删之后：分配器的空闲链表被打散，新节点落在零散的空洞里
+List build_churned(uint64_t count, std::mt19937_64& rng) {
+	List list = build_sequential(count);
+	std::vector<List> bystanders(16);
+	for (uint64_t round = 0; round < 4; ++round) {
+		list.remove_if([&rng](uint64_t) { return rng() % 2 == 0; });
+		for (auto& other : bystanders) {
+			for (uint64_t i = 0; i < count / 64; ++i) {
+				other.push_back(i);
+			}
+		}
+		while (list.size() < count) {
+			if (rng() % 2 == 0) {
+				list.push_back(rng());
+			} else {
+				list.push_front(rng());
+			}
+		}
+		bystanders[rng() % bystanders.size()].clear();
+	}
+	return list;
+}
+
+void profile(const char* name, const List& list) {
+	const uint64_t count = list.size();
+
+	PerfCounter llc_misses(PerfCounter::Event::LlcReadMiss);
+	PerfCounter dtlb_misses(PerfCounter::Event::DtlbReadMiss);
+
+	// 整体遍历：只在首尾取时间戳，得到每个元素的平均开销
+	uint64_t checksum = 0;
+	llc_misses.start();
+	dtlb_misses.start();
+	const uint64_t walk_start = timestamp();
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		checksum += *it;
+	}
+	const uint64_t walk_end = timestamp();
+	const uint64_t llc = llc_misses.stop();
+	const uint64_t dtlb = dtlb_misses.stop();
+
+	// 逐元素计时：每一步都取时间戳，得到延迟分布（包含计时本身的开销）
+	Histogram histogram;
+	uint64_t previous = timestamp();
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		checksum += *it;
+		const uint64_t now = timestamp();
+		histogram.add(now - previous);
+		previous = now;
+	}
+
+	std::printf("%s: %llu elements\n", name, static_cast<unsigned long long>(count));
+	std::printf("  %s per element: %.2f\n", timestamp_unit(),
+	            static_cast<double>(walk_end - walk_start) / static_cast<double>(count));
+	if (llc_misses.valid()) {
+		std::printf("  LLC misses per element : %.3f\n", static_cast<double>(llc) / static_cast<double>(count));
+	} else {
+		std::printf("  LLC misses per element : unavailable\n");
+	}
+	if (dtlb_misses.valid()) {
+		std::printf("  dTLB misses per element: %.3f\n", static_cast<double>(dtlb) / static_cast<double>(count));
+	} else {
+		std::printf("  dTLB misses per element: unavailable\n");
+	}
+	std::printf("  per-element latency (%s):\n", timestamp_unit());
+	histogram.print(count);
+	std::printf("  checksum: %llu\n\n", static_cast<unsigned long long>(checksum));
+}
+}
+
+// 用法：profile.out [元素个数] [sequential|shuffled|churned|all]
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+	const std::string pattern = argc > 2 ? argv[2] : "all";
+	std::mt19937_64 rng(12345);
+
+	if (pattern == "all" || pattern == "sequential") {
+		profile("sequential", build_sequential(count));
+	}
+	if (pattern == "all" || pattern == "shuffled") {
+		profile("shuffled", build_shuffled(count, rng));
+	}
+	if (pattern == "all" || pattern == "churned") {
+		profile("churned", build_churned(count, rng));
+	}
+	return 0;
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "../DoublyLinkedList/DoublyLinkedList.hpp"
+#include "../NodeArena/NodeArena.hpp"
+#include "../XorLinkedList/XorLinkedList.hpp"
+#include "DoNotOptimize.hpp"
+
+using namespace mystl;
+
+namespace {
+// 堆上实际占用的字节数，包含 malloc 自身的块头和对齐
+std::size_t heap_in_use() {
+#ifdef __GLIBC__
+	return mallinfo2().uordblks;
+#else
+	return 0;
+#endif
+}
+
+template <typename List>
+double walk_ns_per_element(const List& list) {
+	uint64_t checksum = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (auto it = list.begin(); it != list.end(); ++it) {
+		checksum += *it;
+	}
+	const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	do_not_optimize(checksum);
+	return elapsed / static_cast<double>(list.size());
+}
+
+template <typename List>
+void report_malloc(const char* name, uint64_t count) {
+	const std::size_t before = heap_in_use();
+	List list;
+	for (uint64_t i = 0; i < count; ++i) {
+		list.push_back(i);
+	}
+	const double bytes = static_cast<double>(heap_in_use() - before) / static_cast<double>(count);
+	std::printf("%-22s node %2zu B  heap %6.2f B/element  walk %6.2f ns/element\n", name, sizeof(typename List::Node),
+	            bytes, walk_ns_per_element(list));
+}
+
+template <typename List>
+void report_arena(const char* name, uint64_t count) {
+	NodeArena arena(ArenaOptions{.huge_pages = HugePagePolicy::None});
+	List list{ArenaAllocator<uint64_t>(arena)};
+	for (uint64_t i = 0; i < count; ++i) {
+		list.push_back(i);
+	}
+	const double bytes = static_cast<double>(arena.bytes_reserved()) / static_cast<double>(count);
+	std::printf("%-22s node %2zu B  arena %5.2f B/element  walk %6.2f ns/element\n", name, sizeof(typename List::Node),
+	            bytes, walk_ns_per_element(list));
+}
+}
+
+// 用法：xor_bench.out [元素个数]
+int main(int argc, char** argv) {
+	const uint64_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+
+	// malloc 以 16 字节为粒度并带 8 字节块头，节点小于 24 字节时收益会被取整吃掉一部分
+	report_malloc<DoublyLinkedList<uint64_t>>("DoublyLinkedList", count);
+	report_malloc<XorLinkedList<uint64_t>>("XorLinkedList", count);
+
+	report_arena<DoublyLinkedList<uint64_t, ArenaAllocator<uint64_t>>>("DoublyLinkedList arena", count);
+	report_arena<XorLinkedList<uint64_t, ArenaAllocator<uint64_t>>>("XorLinkedList arena", count);
+	return 0;
+}
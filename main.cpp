@@ -1,8 +1,64 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <deque>
+#include <execution>
+#include <iterator>
+#include <new>
+#include <atomic>
+#include <random>
+#include <ranges>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
 #include "./DoublyLinkedList/DoublyLinkedList.hpp"
+#include "./PersistentList/PersistentList.hpp"
+#include "./CowDoublyLinkedList/CowDoublyLinkedList.hpp"
+#include "./NodeArena/NodeArena.hpp"
+#include "./ThreadCacheAllocator/ThreadCacheAllocator.hpp"
+#include "./EpochReclamation/EpochReclamation.hpp"
+#include "./RcuList/RcuList.hpp"
+#include "./SortedList/SortedList.hpp"
+#include "./TimingWheel/TimingWheel.hpp"
+#include "./RingDeque/RingDeque.hpp"
+#include "./StaticDoublyLinkedList/StaticDoublyLinkedList.hpp"
+#include "./XorLinkedList/XorLinkedList.hpp"
+#include "./CompactDoublyLinkedList/CompactDoublyLinkedList.hpp"
+#include "./SpillableList/SpillableList.hpp"
+#include "./DurableList/DurableList.hpp"
+#include "./AsyncQueue/AsyncQueue.hpp"
+#include "./BlockingQueue/BlockingQueue.hpp"
+#include "./MultiLevelQueue/MultiLevelQueue.hpp"
 
 using namespace mystl;
 
+// 统计本线程的堆分配次数，用于验证某些操作不分配内存
+static thread_local std::size_t g_allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocation_count;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// std::stable_sort 的临时缓冲区走 nothrow 版本，也要与下面的 free 配对
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++g_allocation_count;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
 // 单元测试类
 class DoublyLinkedListTest : public ::testing::Test {
 protected:
@@ -17,7 +73,7 @@ protected:
 
 // 测试构造函数（正常情况）
 TEST_F(DoublyLinkedListTest, ConstructionHappyPath) {
-    DoublyLinkedList<int> list{3, 10}; // 创建一个包含3个10的链表
+    DoublyLinkedList<int> list(3, 10); // 创建一个包含3个10的链表
     EXPECT_EQ(list.size(), 3); // 期望大小为3
     EXPECT_EQ(list.front(), 10); // 期望头部元素为10
     EXPECT_EQ(list.back(), 10);  // 期望尾部元素为10
@@ -48,7 +104,7 @@ TEST_F(DoublyLinkedListTest, PushBack) {
 
 // 测试弹出元素（正常情况：从后面弹出）
 TEST_F(DoublyLinkedListTest, PopBack) {
-    DoublyLinkedList<int> list{2, 10}; // 创建包含两个10的链表
+    DoublyLinkedList<int> list(2, 10); // 创建包含两个10的链表
     list.pop_back(); // 从尾部弹出一个元素
     EXPECT_EQ(list.size(), 1); // 期望大小为1
     EXPECT_EQ(list.back(), 10); // 期望尾部元素为10
@@ -56,7 +112,7 @@ TEST_F(DoublyLinkedListTest, PopBack) {
 
 // 测试弹出元素（正常情况：从前面弹出）
 TEST_F(DoublyLinkedListTest, PopFront) {
-    DoublyLinkedList<int> list{2, 20}; // 创建包含两个20的链表
+    DoublyLinkedList<int> list(2, 20); // 创建包含两个20的链表
     list.pop_front(); // 从头部弹出一个元素
     EXPECT_EQ(list.size(), 1); // 期望大小为1
     EXPECT_EQ(list.front(), 20); // 期望头部元素为20
@@ -71,7 +127,7 @@ TEST_F(DoublyLinkedListTest, PopFromEmptyList) {
 
 // 测试清空链表
 TEST_F(DoublyLinkedListTest, ClearList) {
-    DoublyLinkedList<int> list{5, 30}; // 创建包含5个30的链表
+    DoublyLinkedList<int> list(5, 30); // 创建包含5个30的链表
     list.clear(); // 清空链表
     EXPECT_TRUE(list.empty()); // 期望链表为空
     EXPECT_EQ(list.size(), 0); // 期望大小为0
@@ -79,7 +135,7 @@ TEST_F(DoublyLinkedListTest, ClearList) {
 
 // 测试插入元素
 TEST_F(DoublyLinkedListTest, Insert) {
-    DoublyLinkedList<int> list{3, 40}; // 创建包含3个40的链表
+    DoublyLinkedList<int> list(3, 40); // 创建包含3个40的链表
     auto it = list.begin(); // 获取迭代器
     list.insert(it, 50); // 在头部插入50
     EXPECT_EQ(list.front(), 50); // 期望头部元素为50
@@ -88,7 +144,7 @@ TEST_F(DoublyLinkedListTest, Insert) {
 
 // 测试拷贝构造函数
 TEST_F(DoublyLinkedListTest, CopyConstructor) {
-    DoublyLinkedList<int> original{3, 60}; // 创建原始链表
+    DoublyLinkedList<int> original(3, 60); // 创建原始链表
     DoublyLinkedList<int> copy = original; // 拷贝构造
     EXPECT_EQ(copy.size(), original.size()); // 期望大小相等
     EXPECT_EQ(copy.front(), original.front()); // 期望头部元素相等
@@ -96,12 +152,1871 @@ TEST_F(DoublyLinkedListTest, CopyConstructor) {
 
 // 测试移动构造函数
 TEST_F(DoublyLinkedListTest, MoveConstructor) {
-    DoublyLinkedList<int> original{3, 70}; // 创建原始链表
+    DoublyLinkedList<int> original(3, 70); // 创建原始链表
     DoublyLinkedList<int> moved = std::move(original); // 移动构造
     EXPECT_TRUE(original.empty()); // 原始链表应为空
     EXPECT_EQ(moved.size(), 3); // 移动后链表大小应为3
 }
 
+// 测试初始化列表构造
+TEST_F(DoublyLinkedListTest, InitializerListConstructor) {
+    DoublyLinkedList<int> list{1, 2, 3}; // 创建包含1、2、3的链表
+    EXPECT_EQ(list.size(), 3); // 期望大小为3
+    EXPECT_EQ(list.front(), 1); // 期望头部元素为1
+    EXPECT_EQ(list.back(), 3); // 期望尾部元素为3
+}
+
+// 测试拷贝后两个链表互不影响
+TEST_F(DoublyLinkedListTest, CopyIsIndependent) {
+    DoublyLinkedList<int> original{1, 2, 3};
+    DoublyLinkedList<int> copy = original;
+    copy.pop_front();
+    EXPECT_EQ(original.size(), 3); // 原链表不受影响
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy.front(), 2);
+}
+
+// 测试空链表的构造、移动和析构不分配内存
+TEST_F(DoublyLinkedListTest, EmptyListDoesNotAllocate) {
+    const auto before = g_allocation_count;
+    {
+        DoublyLinkedList<int> empty;
+        DoublyLinkedList<int> moved = std::move(empty);
+        DoublyLinkedList<int> assigned;
+        assigned = std::move(moved);
+        EXPECT_TRUE(assigned.empty());
+        EXPECT_TRUE(assigned.begin() == assigned.end()); // 空链表 begin 等于 end
+    }
+    EXPECT_EQ(g_allocation_count, before); // 期望没有发生堆分配
+}
+
+// 测试移动后哨兵重新链接，两个链表都可以继续使用
+TEST_F(DoublyLinkedListTest, MoveRelinksSentinel) {
+    DoublyLinkedList<int> original{1, 2, 3};
+    DoublyLinkedList<int> moved = std::move(original);
+
+    int sum = 0;
+    for (auto it = moved.begin(); it != moved.end(); ++it) {
+        sum += *it;
+    }
+    EXPECT_EQ(sum, 6); // 遍历应正确终止于新的哨兵
+
+    moved.push_front(0);
+    moved.push_back(4);
+    EXPECT_EQ(moved.front(), 0);
+    EXPECT_EQ(moved.back(), 4);
+
+    original.push_back(9); // 被移动后的链表可以直接复用
+    EXPECT_EQ(original.size(), 1);
+    EXPECT_EQ(original.front(), 9);
+}
+
+// 测试按迭代器删除单个元素
+TEST_F(DoublyLinkedListTest, EraseSingle) {
+    DoublyLinkedList<int> list{1, 2, 3};
+    auto it = list.begin();
+    ++it;
+    auto next = list.erase(it); // 删除元素2
+    EXPECT_EQ(*next, 3); // 返回被删除元素的下一个位置
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 3);
+}
+
+// 测试按区间删除
+TEST_F(DoublyLinkedListTest, EraseRange) {
+    DoublyLinkedList<int> list{1, 2, 3, 4, 5};
+    auto first = list.begin();
+    ++first;
+    auto last = first;
+    ++last;
+    ++last;
+    list.erase(first, last); // 删除2和3
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(*++list.begin(), 4);
+
+    list.erase(list.begin(), list.end()); // 删除全部元素
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+// 测试 remove / remove_if / erase_if
+TEST_F(DoublyLinkedListTest, RemoveIf) {
+    DoublyLinkedList<int> list{1, 2, 3, 4, 5, 6, 2};
+    EXPECT_EQ(list.remove(2), 2); // 删除所有的2
+    EXPECT_EQ(list.size(), 5);
+
+    EXPECT_EQ(erase_if(list, [](int x) { return x % 2 == 1; }), 3); // 删除所有奇数
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(list.front(), 4);
+    EXPECT_EQ(list.back(), 6);
+
+    EXPECT_EQ(erase(list, 4), 1);
+    EXPECT_EQ(list.size(), 1);
+}
+
+// 测试 remove 的参数引用链表自身元素的情况
+TEST_F(DoublyLinkedListTest, RemoveSelfReference) {
+    DoublyLinkedList<int> list{7, 1, 7, 2, 7};
+    EXPECT_EQ(list.remove(*list.begin()), 3); // 参数引用的节点也会被删除
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 2);
+}
+
+// 测试删除相邻重复元素
+TEST_F(DoublyLinkedListTest, Unique) {
+    DoublyLinkedList<int> list{1, 1, 2, 2, 2, 3, 1, 1};
+    EXPECT_EQ(list.unique(), 4);
+    EXPECT_EQ(list.size(), 4);
+
+    int expected[] = {1, 2, 3, 1};
+    int i = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        EXPECT_EQ(*it, expected[i++]);
+    }
+}
+
+// 记录拷贝和移动次数的元素类型
+struct CopyCounter {
+    static inline int copies = 0;
+    static inline int moves = 0;
+    int value = 0;
+
+    CopyCounter() = default;
+    explicit CopyCounter(int v) : value{v} {}
+    CopyCounter(const CopyCounter& other) : value{other.value} { ++copies; }
+    CopyCounter(CopyCounter&& other) noexcept : value{other.value} { ++moves; }
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&& other) noexcept { value = other.value; ++moves; return *this; }
+};
+
+// 测试节点句柄在两个链表之间转移，不分配内存也不拷贝元素
+TEST_F(DoublyLinkedListTest, ExtractAndInsertNode) {
+    DoublyLinkedList<CopyCounter> from;
+    from.push_back(CopyCounter{1});
+    from.push_back(CopyCounter{2});
+    DoublyLinkedList<CopyCounter> to;
+    to.push_back(CopyCounter{3});
+
+    auto it = from.begin();
+    ++it;
+    const auto* payload = &*it;
+
+    const auto allocations = g_allocation_count;
+    CopyCounter::copies = 0;
+    CopyCounter::moves = 0;
+
+    auto handle = from.extract(it); // 摘下元素2
+    EXPECT_FALSE(handle.empty());
+    EXPECT_EQ(handle.value().value, 2);
+    EXPECT_EQ(from.size(), 1);
+
+    auto pos = to.insert(to.begin(), std::move(handle)); // 插入到目标链表头部
+    EXPECT_TRUE(handle.empty()); // 句柄已被消耗
+    EXPECT_EQ(&*pos, payload); // 元素地址不变
+    EXPECT_EQ(to.size(), 2);
+
+    EXPECT_EQ(g_allocation_count, allocations); // 没有发生分配
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(CopyCounter::moves, 0);
+    EXPECT_EQ(to.front().value, 2);
+}
+
+// 测试未被重新插入的句柄会释放节点，空句柄插入不改变链表
+TEST_F(DoublyLinkedListTest, DiscardedNodeHandle) {
+    DoublyLinkedList<int> list{1, 2, 3};
+    {
+        auto handle = list.extract(list.begin());
+        EXPECT_EQ(handle.value(), 1);
+    } // 句柄析构时释放节点
+    EXPECT_EQ(list.size(), 2);
+    EXPECT_EQ(list.front(), 2);
+
+    DoublyLinkedList<int>::node_type empty_handle;
+    auto pos = list.insert(list.end(), std::move(empty_handle));
+    EXPECT_TRUE(pos == list.end());
+    EXPECT_EQ(list.size(), 2);
+}
+
+// 测试批量入队与出队
+TEST_F(DoublyLinkedListTest, BatchPushAndPop) {
+    DoublyLinkedList<int, std::allocator<int>, ListStats> list{5};
+    const std::vector<int> tail{6, 7, 8};
+    const std::vector<int> head{1, 2, 3, 4};
+    list.push_back_batch(tail);
+    list.push_front_batch(head);
+    list.push_back_batch(std::span<const int>{});
+    std::vector<int> values;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        values.push_back(*it);
+    }
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8}));
+    EXPECT_EQ(list.stats().pushes, 8); // 含初始化列表构造时的一次
+
+    std::vector<int> out(3);
+    EXPECT_EQ(list.pop_front_batch(out, 2), 2); // 受 n 限制
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(list.pop_back_batch(out, 10), 3); // 受 out 大小限制
+    EXPECT_EQ(out, (std::vector<int>{8, 7, 6}));
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front(), 3);
+    EXPECT_EQ(list.back(), 5);
+
+    EXPECT_EQ(list.pop_front_batch(out, 10), 3); // 取空
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.pop_back_batch(out, 10), 0);
+    list.push_back(9); // 哨兵仍然完好
+    EXPECT_EQ(list.front(), 9);
+    EXPECT_EQ(list.stats().pops, 8);
+    EXPECT_EQ(list.stats().bytes_held, sizeof(DoublyLinkedList<int, std::allocator<int>, ListStats>::Node));
+}
+
+// 测试单线程排序稳定、只重新链接节点，比较抛出异常时元素一个不少
+TEST_F(DoublyLinkedListTest, SortIsStableAndRelinksOnly) {
+    DoublyLinkedList<std::pair<int, int>> list;
+    std::vector<std::pair<int, int>> expected;
+    std::mt19937 rng(48);
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back({static_cast<int>(rng() % 50), i});
+        expected.emplace_back(list.back());
+    }
+    std::vector<const std::pair<int, int>*> addresses(1000);
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        addresses[(*it).second] = &*it;
+    }
+
+    auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+    list.sort(by_key);
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    auto expected_it = expected.begin();
+    for (auto it = list.begin(); it != list.end(); ++it, ++expected_it) {
+        EXPECT_EQ(*it, *expected_it);
+        EXPECT_EQ(&*it, addresses[(*it).second]); // 元素没有被移动
+    }
+    EXPECT_EQ(list.back(), expected.back());
+
+    int calls = 0;
+    EXPECT_THROW(list.sort([&calls](const auto& a, const auto& b) {
+        if (++calls == 3000) {
+            throw std::runtime_error("comparison failed");
+        }
+        return a.second > b.second;
+    }), std::runtime_error);
+    std::vector<int> seen;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        seen.push_back((*it).second);
+    }
+    uint64_t backward = 0;
+    for (auto it = list.end(); it != list.begin(); --it) {
+        ++backward;
+    }
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen.size(), 1000);
+    EXPECT_EQ(backward, 1000);
+    EXPECT_EQ(seen.front(), 0);
+    EXPECT_EQ(seen.back(), 999);
+    EXPECT_EQ(std::adjacent_find(seen.begin(), seen.end()), seen.end());
+}
+
+// 测试并行排序与 std::stable_sort 结果一致，包括大量重复元素和已排序、逆序的输入
+TEST_F(DoublyLinkedListTest, ParallelSortMatchesStableSort) {
+    std::mt19937 rng(480);
+    auto check = [](std::vector<std::pair<uint32_t, uint32_t>> values, uint32_t threads) {
+        DoublyLinkedList<std::pair<uint32_t, uint32_t>> list;
+        list.push_back_batch(values);
+        auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+        list.sort(std::execution::par, by_key, threads);
+        std::stable_sort(values.begin(), values.end(), by_key);
+
+        ASSERT_EQ(list.size(), values.size());
+        auto expected_it = values.begin();
+        for (auto it = list.begin(); it != list.end(); ++it, ++expected_it) {
+            ASSERT_EQ(*it, *expected_it);
+        }
+        auto expected_back = values.rbegin();
+        auto it = list.end();
+        for (--it; expected_back != values.rend(); --it, ++expected_back) {
+            ASSERT_EQ(*it, *expected_back); // _prev 链也已重建
+        }
+    };
+
+    const uint32_t count = 200000;
+    std::vector<std::pair<uint32_t, uint32_t>> random, duplicates, descending, equal;
+    for (uint32_t i = 0; i < count; ++i) {
+        random.emplace_back(static_cast<uint32_t>(rng()), i);
+        duplicates.emplace_back(static_cast<uint32_t>(rng() % 7), i);
+        descending.emplace_back(count - i, i);
+        equal.emplace_back(42, i);
+    }
+    check(random, 4);
+    check(random, 3);
+    check(duplicates, 5);
+    check(descending, 4);
+    check(equal, 4);
+
+    DoublyLinkedList<int> small{3, 1, 2};
+    small.sort(std::execution::par); // 太短，退化为单线程
+    EXPECT_EQ(small.front(), 1);
+    EXPECT_EQ(small.back(), 3);
+}
+
+// 测试单线程与并行的稳定划分
+TEST_F(DoublyLinkedListTest, StablePartition) {
+    DoublyLinkedList<int> list{5, 2, 8, 1, 6, 3};
+    auto is_even = [](int val) { return val % 2 == 0; };
+    auto boundary = list.stable_partition(is_even);
+    std::vector<int> values;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        values.push_back(*it);
+    }
+    EXPECT_EQ(values, (std::vector<int>{2, 8, 6, 5, 1, 3}));
+    EXPECT_EQ(*boundary, 5);
+    EXPECT_TRUE(list.stable_partition([](int) { return true; }) == list.end());
+
+    std::vector<int> expected;
+    DoublyLinkedList<int> big;
+    std::mt19937 rng(4800);
+    for (int i = 0; i < 100000; ++i) {
+        expected.push_back(static_cast<int>(rng() % 1000));
+    }
+    big.push_back_batch(expected);
+    auto small_value = [](int val) { return val < 300; };
+    boundary = big.stable_partition(std::execution::par, small_value, 4);
+    std::stable_partition(expected.begin(), expected.end(), small_value);
+
+    auto expected_it = expected.begin();
+    int64_t before_boundary = 0;
+    bool reached = false;
+    for (auto it = big.begin(); it != big.end(); ++it, ++expected_it) {
+        ASSERT_EQ(*it, *expected_it);
+        reached = reached || it == boundary;
+        before_boundary += reached ? 0 : 1;
+    }
+    EXPECT_EQ(before_boundary, std::count_if(expected.begin(), expected.end(), small_value));
+    EXPECT_EQ(big.size(), expected.size());
+}
+
+// 测试反向迭代器，以及与 std::ranges 视图、算法的配合
+TEST_F(DoublyLinkedListTest, ReverseIterationAndRanges) {
+    static_assert(std::bidirectional_iterator<DoublyLinkedList<int>::iterator>);
+    static_assert(std::ranges::bidirectional_range<DoublyLinkedList<int>>);
+
+    DoublyLinkedList<int> list{1, 2, 3, 4, 5, 6};
+    std::vector<int> reversed(list.rbegin(), list.rend());
+    EXPECT_EQ(reversed, (std::vector<int>{6, 5, 4, 3, 2, 1}));
+    EXPECT_EQ(*std::prev(list.end()), 6); // 从哨兵后退得到最后一个元素
+    EXPECT_EQ(*--list.end(), 6);
+
+    auto pipeline = list | std::views::reverse | std::views::filter([](int val) { return val % 2 == 0; }) |
+                    std::views::transform([](int val) { return val * 10; });
+    EXPECT_EQ(std::vector<int>(pipeline.begin(), pipeline.end()), (std::vector<int>{60, 40, 20}));
+
+    for (int& val : list | std::views::take(2)) { // 视图直接引用链表中的元素
+        val *= 100;
+    }
+    EXPECT_EQ(list.front(), 100);
+    EXPECT_EQ(*std::next(list.begin()), 200);
+
+    auto middle = list.subrange(std::next(list.begin(), 2), std::prev(list.end()));
+    EXPECT_EQ(std::ranges::distance(middle), 3);
+    EXPECT_EQ(std::vector<int>(middle.begin(), middle.end()), (std::vector<int>{3, 4, 5}));
+    EXPECT_EQ(*std::ranges::find(middle, 4), 4);
+    EXPECT_TRUE(std::ranges::find(middle, 6) == middle.end());
+    std::ranges::reverse(middle);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), (std::vector<int>{100, 200, 5, 4, 3, 6}));
+
+    DoublyLinkedList<int> empty;
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_TRUE(empty.rbegin() == empty.rend());
+    EXPECT_TRUE(std::ranges::empty(empty | std::views::reverse));
+}
+
+// 测试持久化链表的快照不受后续修改影响
+TEST(PersistentListTest, SnapshotIsolation) {
+    PersistentList<int> list{1, 2, 3};
+    auto snapshot = list.snapshot();
+
+    list.push_back(4);
+    list.pop_front();
+    list.set(0, 20);
+
+    EXPECT_EQ(snapshot.size(), 3); // 快照保持原样
+    EXPECT_EQ(snapshot[0], 1);
+    EXPECT_EQ(snapshot[2], 3);
+
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front(), 20);
+    EXPECT_EQ(list.back(), 4);
+}
+
+// 测试与 DoublyLinkedList 之间的相互转换
+TEST(PersistentListTest, ConvertFromAndToDoublyLinkedList) {
+    DoublyLinkedList<int> source{5, 6, 7, 8};
+    PersistentList<int> persistent(source);
+    EXPECT_EQ(persistent.size(), 4);
+    EXPECT_EQ(persistent[1], 6);
+
+    auto back = static_cast<DoublyLinkedList<int>>(persistent);
+    EXPECT_EQ(back.size(), 4);
+    EXPECT_EQ(back.front(), 5);
+    EXPECT_EQ(back.back(), 8);
+}
+
+// 测试随机插入删除的结果与 std::vector 一致
+TEST(PersistentListTest, RandomOperationsMatchVector) {
+    std::mt19937 rng(42);
+    PersistentList<int> list;
+    std::vector<int> expected;
+    std::vector<std::pair<PersistentList<int>, std::vector<int>>> versions;
+
+    for (int i = 0; i < 2000; ++i) {
+        const auto op = rng() % 4;
+        if (op < 2 || expected.empty()) {
+            const auto index = rng() % (expected.size() + 1);
+            list.insert(index, i);
+            expected.insert(expected.begin() + index, i);
+        } else if (op == 2) {
+            const auto index = rng() % expected.size();
+            list.erase(index);
+            expected.erase(expected.begin() + index);
+        } else {
+            const auto index = rng() % expected.size();
+            list.set(index, -i);
+            expected[index] = -i;
+        }
+        if (i % 200 == 0) {
+            versions.emplace_back(list.snapshot(), expected);
+        }
+    }
+
+    std::vector<int> actual(list.begin(), list.end());
+    EXPECT_EQ(actual, expected);
+
+    for (const auto& [snapshot, values] : versions) { // 所有历史版本都保持不变
+        EXPECT_EQ(std::vector<int>(snapshot.begin(), snapshot.end()), values);
+    }
+}
+
+// 测试写时复制：拷贝共享节点链，修改时才分离
+TEST(CowDoublyLinkedListTest, CopySharesUntilWrite) {
+    CowDoublyLinkedList<int> original{1, 2, 3};
+    const auto allocations = g_allocation_count;
+    CowDoublyLinkedList<int> copy = original;
+    EXPECT_EQ(g_allocation_count, allocations); // 拷贝不分配内存
+    EXPECT_TRUE(copy.shared());
+    EXPECT_EQ(&*copy.begin(), &*original.begin()); // 两者共享同一条链
+
+    copy.push_back(4); // 第一次修改触发分离
+    EXPECT_FALSE(copy.shared());
+    EXPECT_FALSE(original.shared());
+    EXPECT_EQ(original.size(), 3);
+    EXPECT_EQ(copy.size(), 4);
+    EXPECT_EQ(copy.back(), 4);
+    EXPECT_EQ(original.back(), 3);
+}
+
+// 测试在共享状态下按迭代器插入和删除会定位到私有链上的对应位置
+TEST(CowDoublyLinkedListTest, IteratorMutationAfterShare) {
+    CowDoublyLinkedList<int> original{1, 2, 3};
+    CowDoublyLinkedList<int> copy = original;
+
+    auto it = copy.begin();
+    ++it;
+    auto inserted = copy.insert(it, 10); // 在2之前插入10
+    EXPECT_EQ(*inserted, 10);
+    EXPECT_EQ(copy.size(), 4);
+    EXPECT_EQ(original.size(), 3);
+
+    auto shared = original;
+    auto next = shared.erase(shared.begin());
+    EXPECT_EQ(*next, 2);
+    EXPECT_EQ(shared.front(), 2);
+    EXPECT_EQ(original.front(), 1);
+
+    CowDoublyLinkedList<int> empty; // 空链表插入不会写到静态空链表上
+    empty.insert(empty.end(), 5);
+    EXPECT_EQ(empty.size(), 1);
+    EXPECT_TRUE(CowDoublyLinkedList<int>().empty());
+}
+
+// 测试 clear 与 pop 在共享状态下不影响其他拷贝
+TEST(CowDoublyLinkedListTest, ClearAndPopDetach) {
+    CowDoublyLinkedList<int> original{1, 2, 3};
+    auto cleared = original;
+    cleared.clear();
+    EXPECT_TRUE(cleared.empty());
+    EXPECT_EQ(original.size(), 3);
+
+    auto popped = original;
+    popped.pop_front();
+    popped.pop_back();
+    EXPECT_EQ(popped.size(), 1);
+    EXPECT_EQ(popped.front(), 2);
+    EXPECT_EQ(original.size(), 3);
+    EXPECT_THROW(cleared.pop_back(), std::out_of_range);
+}
+
+// 测试经由迭代器的写入先分离，不会影响共享同一条链的其他拷贝
+TEST(CowDoublyLinkedListTest, WriteThroughIteratorDetaches) {
+    CowDoublyLinkedList<int> original{1, 2, 3};
+    CowDoublyLinkedList<int> copy = original;
+
+    static_assert(std::is_same_v<decltype(*std::as_const(copy).begin()), const int&>);
+    EXPECT_EQ(*std::as_const(copy).begin(), 1);
+    EXPECT_TRUE(copy.shared()); // 只读遍历不分离
+
+    *copy.mutable_begin() = 42;
+    EXPECT_FALSE(copy.shared());
+    EXPECT_EQ(copy.front(), 42);
+    EXPECT_EQ(original.front(), 1);
+
+    CowDoublyLinkedList<int> ranged = original;
+    int sum = 0;
+    for (const int& val : ranged) { // 非 const 对象上的范围 for 也只读，不复制节点链
+        sum += val;
+    }
+    EXPECT_EQ(sum, 6);
+    EXPECT_TRUE(ranged.shared());
+    for (auto it = ranged.mutable_begin(); it != ranged.mutable_end(); ++it) {
+        *it *= 10;
+    }
+    EXPECT_FALSE(ranged.shared());
+    EXPECT_EQ(std::vector<int>(ranged.cbegin(), ranged.cend()), (std::vector<int>{10, 20, 30}));
+    EXPECT_EQ(std::vector<int>(original.cbegin(), original.cend()), (std::vector<int>{1, 2, 3}));
+}
+
+// 测试未启用统计时不增加链表和迭代器的体积
+TEST_F(DoublyLinkedListTest, StatsDisabledIsZeroCost) {
+    EXPECT_EQ(sizeof(DoublyLinkedList<int>), sizeof(uint64_t) + 2 * sizeof(void*));
+    EXPECT_EQ(sizeof(DoublyLinkedList<int>::iterator), sizeof(void*));
+}
+
+// 测试统计策略的各项计数
+TEST_F(DoublyLinkedListTest, StatsCounters) {
+    using StatsList = DoublyLinkedList<int, std::allocator<int>, ListStats>;
+    StatsList list;
+    list.push_back(1);
+    list.push_back(2);
+    list.push_front(0);
+    list.insert(list.begin(), -1);
+    list.pop_back();
+    list.remove(0);
+
+    int steps = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        ++steps;
+    }
+
+    const auto stats = list.stats();
+    EXPECT_EQ(stats.pushes, 3);
+    EXPECT_EQ(stats.inserts, 1);
+    EXPECT_EQ(stats.pops, 1);
+    EXPECT_EQ(stats.erases, 1);
+    EXPECT_EQ(stats.node_allocations, 4);
+    EXPECT_EQ(stats.node_frees, 2);
+    EXPECT_EQ(stats.bytes_held, list.size() * sizeof(StatsList::Node));
+    EXPECT_EQ(stats.iterator_steps, steps); // remove 内部遍历不计入，只统计迭代器的移动
+
+    list.reset_stats();
+    EXPECT_EQ(list.stats().pushes, 0);
+    EXPECT_EQ(list.stats().bytes_held, list.size() * sizeof(StatsList::Node)); // 持有字节数不被清零
+
+    StatsList moved = std::move(list); // 移动后持有字节数随节点转移
+    EXPECT_EQ(moved.stats().bytes_held, moved.size() * sizeof(StatsList::Node));
+    EXPECT_EQ(list.stats().bytes_held, 0);
+}
+
+// 测试持有迭代器时链表被移动并析构，迭代器的步数计数不悬空，只读遍历可以并发计数
+TEST_F(DoublyLinkedListTest, StatsIteratorOutlivesMovedList) {
+    using StatsList = DoublyLinkedList<int, std::allocator<int>, ListStats>;
+    auto source = std::make_unique<StatsList>();
+    for (int i = 0; i < 4; ++i) {
+        source->push_back(i);
+    }
+
+    auto it = source->begin();
+    StatsList moved = std::move(*source);
+    source.reset(); // 迭代器仍指向已转移到 moved 的节点
+    int steps = 0;
+    for (; it != moved.end(); ++it) {
+        ++steps;
+    }
+    EXPECT_EQ(steps, 4);
+    EXPECT_EQ(moved.stats().iterator_steps, 0); // 步数记在创建迭代器的那个链表上
+
+    const StatsList& shared = moved;
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&shared] {
+            for (int round = 0; round < 1000; ++round) {
+                for (auto walk = shared.begin(); walk != shared.end(); ++walk) {
+                }
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(moved.stats().iterator_steps, 4 * 1000 * 4);
+}
+
+// 测试链表节点从区域分配器中分配，释放后的节点被复用
+TEST(NodeArenaTest, ListUsesArena) {
+    NodeArena arena(ArenaOptions{.chunk_bytes = 64 * 1024, .huge_pages = HugePagePolicy::None});
+    using ArenaList = DoublyLinkedList<int, ArenaAllocator<int>>;
+    ArenaList list{ArenaAllocator<int>(arena)};
+
+    for (int i = 0; i < 1000; ++i) {
+        list.push_back(i);
+    }
+    EXPECT_EQ(arena.chunk_count(), 1); // 全部节点都切自同一个块
+    EXPECT_EQ(list.get_allocator().arena(), &arena);
+
+    const auto* last = &*--list.end();
+    list.pop_back();
+    list.push_back(42); // 刚释放的节点被立刻复用
+    EXPECT_EQ(&*--list.end(), last);
+
+    ArenaList copy = list; // 拷贝沿用同一个区域
+    EXPECT_EQ(copy.get_allocator().arena(), &arena);
+    EXPECT_EQ(copy.back(), 42);
+}
+
+// 移动赋值时不传播的区域分配器
+template <typename T>
+struct StickyArenaAllocator : ArenaAllocator<T> {
+    using ArenaAllocator<T>::ArenaAllocator;
+    using propagate_on_container_move_assignment = std::false_type;
+};
+
+// 测试分配器不传播且不相等时，移动赋值逐个移动元素，而不是接管另一个区域的节点
+TEST(NodeArenaTest, MoveAssignAcrossArenas) {
+    NodeArena arena_a(ArenaOptions{.chunk_bytes = 64 * 1024, .huge_pages = HugePagePolicy::None});
+    NodeArena arena_b(ArenaOptions{.chunk_bytes = 64 * 1024, .huge_pages = HugePagePolicy::None});
+    using StickyList = DoublyLinkedList<int, StickyArenaAllocator<int>>;
+    static_assert(!std::is_nothrow_move_assignable_v<StickyList>);
+
+    StickyList target{StickyArenaAllocator<int>(arena_a)};
+    StickyList source{StickyArenaAllocator<int>(arena_b)};
+    for (int i = 0; i < 100; ++i) {
+        source.push_back(i);
+    }
+    target = std::move(source);
+    EXPECT_EQ(target.get_allocator().arena(), &arena_a);
+    EXPECT_EQ(arena_a.live_blocks(), 100);
+    EXPECT_EQ(arena_b.live_blocks(), 0);
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(std::vector<int>(target.begin(), target.end()).back(), 99);
+
+    StickyList same{StickyArenaAllocator<int>(arena_a)};
+    const int* first = &*target.begin();
+    same = std::move(target); // 分配器相等时仍然直接接管节点
+    EXPECT_EQ(&*same.begin(), first);
+    EXPECT_EQ(same.size(), 100);
+}
+
+// 测试节点句柄只能插入分配器相等的链表
+TEST(NodeArenaTest, InsertNodeRequiresEqualAllocator) {
+    NodeArena arena_a(ArenaOptions{.chunk_bytes = 64 * 1024, .huge_pages = HugePagePolicy::None});
+    NodeArena arena_b(ArenaOptions{.chunk_bytes = 64 * 1024, .huge_pages = HugePagePolicy::None});
+    using ArenaList = DoublyLinkedList<int, ArenaAllocator<int>>;
+    ArenaList from{ArenaAllocator<int>(arena_a)};
+    ArenaList other_arena{ArenaAllocator<int>(arena_b)};
+    ArenaList same_arena{ArenaAllocator<int>(arena_a)};
+    from.push_back(7);
+
+    auto node = from.extract(from.begin());
+    EXPECT_THROW(other_arena.insert(other_arena.end(), std::move(node)), std::invalid_argument);
+    EXPECT_FALSE(node.empty()); // 失败时句柄仍持有节点
+    EXPECT_TRUE(other_arena.empty());
+
+    same_arena.insert(same_arena.end(), std::move(node));
+    EXPECT_TRUE(node.empty());
+    EXPECT_EQ(same_arena.front(), 7);
+}
+
+// 测试区域里只剩本链表的节点时 clear 整体重置区域并保留块，有其他存活的块时退化为逐个释放
+TEST(NodeArenaTest, ClearReleasesArenaInBulk) {
+    NodeArena arena(ArenaOptions{.chunk_bytes = 64 * 1024, .huge_pages = HugePagePolicy::None});
+    using ArenaList = DoublyLinkedList<uint64_t, ArenaAllocator<uint64_t>, ListStats>;
+    ArenaList list{ArenaAllocator<uint64_t>(arena)};
+    for (uint64_t i = 0; i < 10000; ++i) {
+        list.push_back(i);
+    }
+    EXPECT_EQ(arena.live_blocks(), 10000);
+    EXPECT_GT(arena.chunk_count(), 1);
+
+    const auto chunks = arena.chunk_count();
+    const auto reserved = arena.bytes_reserved();
+    const auto* first = &*list.begin();
+    list.clear();
+    EXPECT_EQ(arena.chunk_count(), chunks); // 块保留下来，只重置区域
+    EXPECT_EQ(arena.bytes_reserved(), reserved);
+    EXPECT_EQ(arena.live_blocks(), 0);
+    EXPECT_EQ(list.stats().node_frees, 10000);
+    EXPECT_EQ(list.stats().bytes_held, 0);
+    EXPECT_TRUE(list.empty());
+    for (uint64_t i = 0; i < 10000; ++i) {
+        list.push_back(i); // 重新填满时从第一个块开始复用，不再申请新块
+    }
+    EXPECT_EQ(&*list.begin(), first);
+    EXPECT_EQ(arena.chunk_count(), chunks);
+    list.clear();
+    list.push_back(7); // 清空后照常使用
+    EXPECT_EQ(list.front(), 7);
+
+    // 另一条链表共用这个区域，或者还有未归还的 node_type 时，只能逐个释放
+    ArenaList other{ArenaAllocator<uint64_t>(arena)};
+    other.push_back(1);
+    list.clear();
+    EXPECT_EQ(arena.live_blocks(), 1);
+    EXPECT_EQ(other.front(), 1);
+
+    list.push_back(2);
+    list.push_back(3);
+    auto node = other.extract(other.begin());
+    list.clear();
+    EXPECT_EQ(arena.live_blocks(), 1);
+    EXPECT_EQ(node.value(), 1);
+}
+
+// 测试整块释放前仍会析构每一个元素
+TEST(NodeArenaTest, BulkClearRunsDestructors) {
+    auto token = std::make_shared<int>(0);
+    {
+        NodeArena arena(ArenaOptions{.chunk_bytes = 64 * 1024, .huge_pages = HugePagePolicy::None});
+        DoublyLinkedList<std::shared_ptr<int>, ArenaAllocator<std::shared_ptr<int>>> list{
+            ArenaAllocator<std::shared_ptr<int>>(arena)};
+        for (int i = 0; i < 5000; ++i) {
+            list.push_back(token);
+        }
+        EXPECT_EQ(token.use_count(), 5001);
+        list.clear();
+        EXPECT_EQ(token.use_count(), 1);
+        EXPECT_EQ(arena.live_blocks(), 0);
+
+        list.push_back(token);
+    } // 析构函数同样整块释放
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+// 测试大页和 NUMA 绑定不可用时平稳退化
+TEST(NodeArenaTest, GracefulFallback) {
+    NodeArena arena(ArenaOptions{.chunk_bytes = 4096, .huge_pages = HugePagePolicy::Explicit, .numa_node = 4095});
+    void* block = arena.allocate(24, 8);
+    ASSERT_NE(block, nullptr);
+    EXPECT_FALSE(arena.numa_bound()); // 不存在的 NUMA 节点绑定失败，但分配仍然成功
+
+    void* large = arena.allocate(10000, 64); // 超过块大小的请求会单独申请一个更大的块
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 64, 0);
+    EXPECT_EQ(arena.chunk_count(), 2);
+
+    arena.reset(); // 重置后先复用已有的块，放不下的请求跳过小块
+    EXPECT_EQ(arena.allocate(24, 8), block);
+    EXPECT_EQ(arena.allocate(10000, 64), large);
+    EXPECT_EQ(arena.chunk_count(), 2);
+
+    arena.release_all();
+    EXPECT_EQ(arena.chunk_count(), 0);
+    EXPECT_EQ(arena.bytes_reserved(), 0);
+}
+
+// 测试大页查询：申请被接受不等于已由大页映射，未申请时两者都为假
+TEST(NodeArenaTest, HugePageQueries) {
+    NodeArena plain(ArenaOptions{.chunk_bytes = std::size_t{4} << 20, .huge_pages = HugePagePolicy::None});
+    std::memset(plain.allocate(64, 16), 1, 64);
+    EXPECT_FALSE(plain.huge_pages_requested());
+    EXPECT_FALSE(plain.huge_pages_active());
+
+    NodeArena transparent(ArenaOptions{.chunk_bytes = std::size_t{4} << 20, .huge_pages = HugePagePolicy::Transparent});
+    char* block = static_cast<char*>(transparent.allocate(64, 16));
+    std::memset(block, 1, (std::size_t{4} << 20) - 4096); // 先写入，透明大页只在缺页时分配
+    if (transparent.huge_pages_active()) {
+        EXPECT_TRUE(transparent.huge_pages_requested());
+    }
+}
+
+// 测试同一线程内释放的节点被立即复用
+TEST(ThreadCacheAllocatorTest, LocalReuse) {
+    DoublyLinkedList<int, ThreadCacheAllocator<int>> list;
+    list.push_back(1);
+    const auto* node = &*list.begin();
+    list.pop_back();
+    list.push_back(2);
+    EXPECT_EQ(&*list.begin(), node);
+}
+
+// 测试其他线程释放的节点成批交还给分配它的线程并被复用
+TEST(ThreadCacheAllocatorTest, RemoteFreesReturnToOwner) {
+    using CachedList = DoublyLinkedList<int, ThreadCacheAllocator<int>>;
+    CachedList list;
+    std::set<const void*> allocated;
+    for (int i = 0; i < 256; ++i) {
+        list.push_back(i);
+        allocated.insert(&*--list.end());
+    }
+
+    std::thread consumer([&list] {
+        while (!list.empty()) {
+            list.pop_front(); // 在另一个线程释放
+        }
+        ThreadCacheAllocator<int>::flush_remote(); // 交还尚未攒满一批的部分
+    });
+    consumer.join();
+
+    int reused = 0;
+    for (int i = 0; i < 256; ++i) {
+        list.push_back(i);
+        reused += allocated.count(&*--list.end());
+    }
+    EXPECT_EQ(reused, 256); // 全部来自被交还的节点
+}
+
+// 比线程缓存上下文先构造的 thread_local 容器，析构时上下文已经析构
+struct LateCachedList {
+    DoublyLinkedList<int, ThreadCacheAllocator<int>> list;
+
+    ~LateCachedList() {
+        list.push_back(-1); // 上下文析构后仍然分配
+    }
+};
+
+// 测试线程退出时，上下文析构之后的分配和释放不访问已析构的上下文，释放的块交还给所属的堆
+TEST(ThreadCacheAllocatorTest, UseAfterThreadContextDestroyed) {
+    std::thread worker([] {
+        thread_local LateCachedList late; // 构造不分配，先于上下文完成构造，于是后析构
+        for (int i = 0; i < 100; ++i) {
+            late.list.push_back(i);
+        }
+    });
+    worker.join();
+
+    // 新线程接管挂起的堆，取回上面释放的块
+    std::thread adopter([] {
+        DoublyLinkedList<int, ThreadCacheAllocator<int>> list;
+        for (int i = 0; i < 1000; ++i) {
+            list.push_back(i);
+        }
+        EXPECT_EQ(list.size(), 1000);
+    });
+    adopter.join();
+}
+
+// 记录析构次数的元素类型
+struct DestructionCounter {
+    static inline int destroyed = 0;
+    int value = 0;
+
+    explicit DestructionCounter(int v) : value{v} {}
+    DestructionCounter(const DestructionCounter& other) = default;
+    ~DestructionCounter() { ++destroyed; }
+};
+
+// 测试 RCU 链表的基本读写
+TEST(RcuListTest, WriterAndReaderView) {
+    EpochDomain domain;
+    RcuList<int> list(domain);
+    list.push_back(2);
+    list.push_back(3);
+    list.push_front(1);
+    list.insert(list.end(), 4);
+    list.pop_back();
+
+    int sum = 0;
+    for (int value : list.read()) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 6);
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 3);
+}
+
+// 测试读者临界区内被删除的节点不会被释放
+TEST(RcuListTest, RetiredNodeOutlivesReader) {
+    EpochDomain domain;
+    RcuList<DestructionCounter> list(domain);
+    list.push_back(DestructionCounter{1});
+    list.push_back(DestructionCounter{2});
+
+    DestructionCounter::destroyed = 0;
+    {
+        auto view = list.read();
+        auto it = view.begin(); // 读者停在第一个节点上
+        list.pop_front(); // 写者删除该节点
+        for (int i = 0; i < 4; ++i) {
+            domain.reclaim();
+        }
+        EXPECT_EQ(DestructionCounter::destroyed, 0); // 读者仍在临界区，节点未释放
+        EXPECT_EQ(it->value, 1);
+        ++it;
+        EXPECT_EQ(it->value, 2); // 仍能沿旧链接继续遍历
+    }
+    domain.synchronize();
+    EXPECT_EQ(DestructionCounter::destroyed, 1);
+    EXPECT_EQ(domain.pending(), 0);
+}
+
+// 测试反复创建和析构域时，线程的读者记录缓存不随析构过的域增长
+TEST(RcuListTest, RecordCacheDropsDeadDomains) {
+    EpochDomain outer;
+    auto outer_guard = outer.guard();
+    for (int i = 0; i < 1000; ++i) {
+        EpochDomain domain;
+        auto guard = domain.guard();
+    }
+    EpochDomain last;
+    auto last_guard = last.guard();
+    EXPECT_LE(epoch_detail::record_cache()._entries.size(), 2); // 只剩 outer 与 last
+}
+
+// 测试读者与写者并发运行
+TEST(RcuListTest, ConcurrentReadersAndWriter) {
+    EpochDomain domain;
+    RcuList<std::pair<int, int>> list(domain);
+    for (int i = 0; i < 100; ++i) {
+        list.push_back({i, -i});
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> corrupted{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                list.for_each([&](const std::pair<int, int>& value) {
+                    if (value.first != -value.second) {
+                        corrupted.fetch_add(1);
+                    }
+                });
+            }
+        });
+    }
+
+    for (int i = 100; i < 20000; ++i) {
+        list.push_back({i, -i});
+        list.pop_front();
+        if (i % 1000 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    domain.synchronize();
+
+    EXPECT_EQ(corrupted.load(), 0);
+    EXPECT_EQ(list.size(), 100);
+    EXPECT_EQ(list.front().first, 19900);
+}
+
+// 测试有序链表的插入、查找与按键删除
+TEST(SortedListTest, InsertAndBounds) {
+    SortedList<int> list{5, 1, 3};
+    list.insert(3);
+    list.insert(4);
+    std::vector<int> values(list.begin(), list.end());
+    EXPECT_EQ(values, (std::vector<int>{1, 3, 3, 4, 5}));
+
+    EXPECT_EQ(*list.lower_bound(3), 3);
+    EXPECT_EQ(*list.upper_bound(3), 4);
+    EXPECT_EQ(list.lower_bound(6), list.end());
+    EXPECT_TRUE(list.contains(4));
+    EXPECT_FALSE(list.contains(2));
+
+    EXPECT_EQ(list.erase(3), 2);
+    EXPECT_EQ(list.erase(2), 0);
+    EXPECT_EQ(list.size(), 3);
+    EXPECT_EQ(list.front(), 1);
+    EXPECT_EQ(list.back(), 5);
+    EXPECT_EQ(list.erase(list.front()), 1); // 键引用链表自身的元素
+    EXPECT_EQ(list.front(), 4);
+}
+
+// 测试有序输入的一次归并插入，以及逆序输入的退化路径
+TEST(SortedListTest, InsertSortedMerges) {
+    SortedList<int> list;
+    for (int i = 0; i < 1000; i += 2) {
+        list.insert(i);
+    }
+    std::vector<int> odds;
+    for (int i = 1; i < 1000; i += 2) {
+        odds.push_back(i);
+    }
+    list.insert_sorted(odds);
+    list.insert_sorted(std::vector<int>{700, 5, -1}); // 非有序输入
+
+    std::vector<int> values(list.begin(), list.end());
+    EXPECT_EQ(values.size(), 1003);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+    EXPECT_EQ(list.front(), -1);
+    EXPECT_EQ(list.back(), 999);
+}
+
+// 测试把链表自身归并进来：每个元素恰好变成两份，且能正常结束
+TEST(SortedListTest, InsertSortedSelf) {
+    SortedList<int> list{3, 1, 2, 2};
+    list.insert_sorted(list);
+    std::vector<int> values(list.begin(), list.end());
+    EXPECT_EQ(values, (std::vector<int>{1, 1, 2, 2, 2, 2, 3, 3}));
+}
+
+// 随机操作与 std::multiset 对照
+TEST(SortedListTest, RandomOperationsMatchMultiset) {
+    SortedList<int, std::greater<int>> list;
+    std::multiset<int, std::greater<int>> expected;
+    std::mt19937 rng(42);
+
+    for (int step = 0; step < 20000; ++step) {
+        const int key = static_cast<int>(rng() % 500);
+        switch (rng() % 5) {
+        case 0:
+        case 1:
+            list.insert(key);
+            expected.insert(key);
+            break;
+        case 2:
+            EXPECT_EQ(list.erase(key), expected.erase(key));
+            break;
+        case 3:
+            if (auto it = list.find(key); it != list.end()) {
+                list.erase(it);
+                expected.erase(expected.find(key));
+            }
+            break;
+        default:
+            if (!list.empty()) {
+                EXPECT_EQ(list.front(), *expected.begin());
+                list.pop_back();
+                expected.erase(std::prev(expected.end()));
+            }
+            break;
+        }
+    }
+
+    SortedList<int, std::greater<int>> copy = list;
+    SortedList<int, std::greater<int>> moved = std::move(list);
+    EXPECT_TRUE(list.empty());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()));
+    EXPECT_TRUE(std::equal(moved.begin(), moved.end(), expected.begin(), expected.end()));
+    EXPECT_EQ(*moved.upper_bound(250), *expected.upper_bound(250));
+}
+
+// 测试时间轮按到期顺序触发，并能取消尚未到期的定时器
+TEST(TimingWheelTest, ScheduleCancelAndExpire) {
+    TimingWheel<int> wheel;
+    auto a = wheel.schedule(5, 5);
+    wheel.schedule(3, 3);
+    auto c = wheel.schedule(4, 4);
+    wheel.schedule_at(0, 1); // 已经过去的时刻在下一个刻度到期
+    EXPECT_TRUE(wheel.cancel(c));
+    EXPECT_FALSE(wheel.cancel(c)); // 重复取消
+    EXPECT_EQ(wheel.size(), 3);
+
+    std::vector<int> fired;
+    EXPECT_EQ(wheel.advance(4, [&](int value) { fired.push_back(value); }), 2);
+    EXPECT_EQ(fired, (std::vector<int>{1, 3}));
+    EXPECT_TRUE(wheel.pending(a));
+
+    wheel.advance(10, [&](int value) { fired.push_back(value); });
+    EXPECT_EQ(fired, (std::vector<int>{1, 3, 5}));
+    EXPECT_FALSE(wheel.pending(a));
+    EXPECT_FALSE(wheel.cancel(a)); // 已到期的句柄
+    EXPECT_TRUE(wheel.empty());
+}
+
+// 测试跨层级联：较小的轮子配合远超单层范围的延迟
+TEST(TimingWheelTest, CascadeMatchesExpiryOrder) {
+    TimingWheel<uint64_t, 2, 3> wheel(7); // 每层 4 个槽，总范围 64 个刻度
+    std::mt19937_64 rng(3);
+    std::vector<uint64_t> expected;
+    for (int i = 0; i < 500; ++i) {
+        const uint64_t expiry = 8 + rng() % 300; // 包括超出总范围的定时器
+        wheel.schedule_at(expiry, expiry);
+        expected.push_back(expiry);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<uint64_t> fired;
+    for (uint64_t now = 7; now < 400; now += 1 + rng() % 5) {
+        wheel.advance(now, [&](uint64_t expiry) {
+            EXPECT_LE(expiry, now);
+            fired.push_back(expiry);
+        });
+        for (uint64_t expiry : fired) {
+            EXPECT_LE(expiry, wheel.now());
+        }
+    }
+    wheel.advance(400, [&](uint64_t expiry) { fired.push_back(expiry); });
+    EXPECT_EQ(fired, expected);
+}
+
+// 测试推进跳过空刻度：远期定时器不会让 advance 逐刻度空转，取消后的空槽也不影响到期时刻
+TEST(TimingWheelTest, AdvanceSkipsIdleTicks) {
+    TimingWheel<uint64_t> wheel;
+    const uint64_t far = uint64_t{1} << 31;
+    wheel.schedule_at(far, far);
+    auto cancelled = wheel.schedule_at(far / 2 + 3, 0);
+    EXPECT_TRUE(wheel.cancel(cancelled));
+
+    std::vector<uint64_t> fired;
+    auto record = [&](uint64_t expiry) { fired.push_back(expiry); };
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(wheel.advance(far / 2 + 10, record), 0);
+    EXPECT_EQ(wheel.advance(far - 1, record), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    EXPECT_EQ(wheel.now(), far - 1);
+
+    wheel.schedule(300, far + 299); // 跨层的近期定时器与远期定时器交错到期
+    EXPECT_EQ(wheel.advance(far + 1000, record), 2);
+    EXPECT_EQ(fired, (std::vector<uint64_t>{far, far + 299}));
+}
+
+// 测试回调中重新调度以及取消同一刻度上的其他定时器
+TEST(TimingWheelTest, CallbackReschedulesAndCancels) {
+    TimingWheel<int> wheel;
+    TimingWheel<int>::timer_handle victim;
+    wheel.schedule(2, 1);
+    victim = wheel.schedule(2, 2);
+
+    std::vector<int> fired;
+    wheel.advance(2, [&](int value) {
+        fired.push_back(value);
+        if (value == 1) {
+            EXPECT_TRUE(wheel.cancel(victim));
+            wheel.schedule(3, 10);
+        }
+    });
+    EXPECT_EQ(fired, (std::vector<int>{1}));
+    EXPECT_EQ(wheel.size(), 1);
+
+    wheel.advance(5, [&](int value) { fired.push_back(value); });
+    EXPECT_EQ(fired, (std::vector<int>{1, 10}));
+}
+
+// 测试回调中 clear：同一刻度上尚未触发的定时器被释放，不再触发，计数不下溢
+TEST(TimingWheelTest, CallbackClearsWheel) {
+    TimingWheel<std::string> wheel;
+    wheel.schedule(2, "a");
+    auto b = wheel.schedule(2, "b");
+    wheel.schedule(2, "c");
+    wheel.schedule(7, "d");
+
+    std::vector<std::string> fired;
+    EXPECT_EQ(wheel.advance(10, [&](std::string&& val) {
+        fired.push_back(val);
+        wheel.clear();
+    }), 1);
+    EXPECT_EQ(fired, (std::vector<std::string>{"a"}));
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_FALSE(wheel.pending(b));
+    EXPECT_EQ(wheel.now(), 10);
+
+    wheel.schedule(1, "e"); // 清空后照常使用
+    EXPECT_EQ(wheel.advance(11, [&](std::string&& val) { fired.push_back(val); }), 1);
+    EXPECT_EQ(fired.back(), "e");
+}
+
+// 测试回调或元素移动抛出异常后，同一刻度上尚未触发的定时器仍然挂在时间轮上
+TEST(TimingWheelTest, ThrowingCallbackKeepsPendingTimers) {
+    TimingWheel<std::string> wheel;
+    wheel.schedule(5, "a");
+    wheel.schedule(5, "b");
+    auto c = wheel.schedule(5, "c");
+    auto d = wheel.schedule(5, "d");
+
+    std::vector<std::string> fired;
+    auto throw_on_b = [&fired](std::string&& val) {
+        fired.push_back(val);
+        if (val == "b") {
+            throw std::runtime_error("callback failed");
+        }
+    };
+    EXPECT_THROW(wheel.advance(5, throw_on_b), std::runtime_error);
+    EXPECT_EQ(fired, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(wheel.size(), 2);
+    EXPECT_TRUE(wheel.pending(c));
+    EXPECT_TRUE(wheel.cancel(d));
+
+    EXPECT_EQ(wheel.advance(6, throw_on_b), 1); // 顺延到下一刻度触发
+    EXPECT_EQ(fired.back(), "c");
+    EXPECT_TRUE(wheel.empty());
+
+    struct ThrowingMove {
+        int id;
+        ThrowingMove(int val) : id{val} {}
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove(ThrowingMove&& ano) : id{ano.id} {
+            if (id == 2) {
+                throw std::runtime_error("move failed");
+            }
+        }
+    };
+    TimingWheel<ThrowingMove> moves;
+    moves.schedule(1, 1);
+    moves.schedule(1, 2);
+    moves.schedule(1, 3);
+    std::vector<int> ids;
+    EXPECT_THROW(moves.advance(1, [&ids](ThrowingMove&& val) { ids.push_back(val.id); }), std::runtime_error);
+    EXPECT_EQ(ids, (std::vector<int>{1}));
+    EXPECT_EQ(moves.size(), 2); // 移动失败的元素没有丢失
+    moves.clear();
+    EXPECT_TRUE(moves.empty());
+}
+
+// 测试环形缓冲区在绕回和扩容后保持顺序
+TEST(RingDequeTest, WrapAroundAndGrow) {
+    RingDeque<int> deque(4);
+    EXPECT_EQ(deque.capacity(), 4);
+    for (int i = 0; i < 3; ++i) {
+        deque.push_back(i);
+    }
+    deque.pop_front();
+    deque.pop_front();
+    deque.push_back(3);
+    deque.push_back(4);
+    deque.push_front(1); // 此时首尾已绕回
+    deque.push_front(0); // 触发扩容
+    EXPECT_EQ(deque.capacity(), 8);
+
+    std::vector<int> values(deque.begin(), deque.end());
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+    EXPECT_EQ(deque.front(), 0);
+    EXPECT_EQ(deque.back(), 4);
+
+    RingDeque<int> copy = deque;
+    deque.pop_back();
+    EXPECT_EQ(copy.size(), 5);
+    EXPECT_EQ(copy.back(), 4);
+    EXPECT_EQ(deque.back(), 3);
+
+    deque.clear();
+    EXPECT_THROW(deque.pop_front(), std::out_of_range);
+}
+
+// 测试覆盖与拒绝两种有界策略
+TEST(RingDequeTest, BoundedPolicies) {
+    RingDeque<int, OverflowPolicy::Overwrite> ring(3); // 向上取整为 4
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(ring.push_back(i));
+    }
+    EXPECT_EQ(std::vector<int>(ring.begin(), ring.end()), (std::vector<int>{2, 3, 4, 5}));
+    ring.push_front(1); // 覆盖队尾
+    EXPECT_EQ(std::vector<int>(ring.begin(), ring.end()), (std::vector<int>{1, 2, 3, 4}));
+
+    RingDeque<std::string, OverflowPolicy::Fail> bounded(2);
+    EXPECT_TRUE(bounded.push_back("a"));
+    EXPECT_TRUE(bounded.push_front("b"));
+    EXPECT_FALSE(bounded.push_back("c"));
+    EXPECT_TRUE(bounded.full());
+    EXPECT_EQ(bounded.front(), "b");
+    bounded.pop_front();
+    EXPECT_TRUE(bounded.push_back("c"));
+    EXPECT_EQ(bounded.back(), "c");
+}
+
+// 测试已满时推入自身的元素：扩容会释放旧缓冲区，元素必须先复制出来
+TEST(RingDequeTest, PushOwnElementWhileFull) {
+    RingDeque<std::string> deque(2);
+    deque.push_back(std::string(32, 'a'));
+    deque.push_back(std::string(32, 'b'));
+    ASSERT_TRUE(deque.full());
+    deque.push_back(deque.front());
+    EXPECT_EQ(deque.capacity(), 4);
+    EXPECT_EQ(deque.back(), std::string(32, 'a'));
+
+    deque.push_back(std::string(32, 'c'));
+    ASSERT_TRUE(deque.full());
+    deque.push_front(deque.back());
+    EXPECT_EQ(deque.capacity(), 8);
+    EXPECT_EQ(std::vector<std::string>(deque.begin(), deque.end()),
+              (std::vector<std::string>{std::string(32, 'c'), std::string(32, 'a'), std::string(32, 'b'),
+                                        std::string(32, 'a'), std::string(32, 'c')}));
+}
+
+// 编译期构造的路由表，整个对象是常量
+constexpr StaticDoublyLinkedList<int, 8> g_static_routes{10, 20, 30};
+
+constexpr int static_list_sum() {
+    StaticDoublyLinkedList<int, 4> list{2, 3};
+    list.push_front(1);
+    list.push_back(4);
+    list.pop_front();
+    auto it = list.begin();
+    ++it;
+    it = list.erase(it); // 删除 3
+    list.insert(it, 5);  // 插到 4 之前
+    int sum = 0;
+    int weight = 1;
+    for (int value : list) {
+        sum += value * weight;
+        weight *= 10;
+    }
+    return sum;
+}
+
+// 测试编译期可用的定长链表
+TEST(StaticDoublyLinkedListTest, ConstexprConstruction) {
+    static_assert(g_static_routes.size() == 3);
+    static_assert(g_static_routes.front() == 10 && g_static_routes.back() == 30);
+    static_assert(static_list_sum() == 452); // 顺序为 2, 5, 4
+
+    std::vector<int> values(g_static_routes.begin(), g_static_routes.end());
+    EXPECT_EQ(values, (std::vector<int>{10, 20, 30}));
+}
+
+// 测试运行期的容量上限与槽位复用
+TEST(StaticDoublyLinkedListTest, CapacityAndReuse) {
+    StaticDoublyLinkedList<std::string, 2> list;
+    list.push_back("a");
+    list.push_front("b");
+    EXPECT_TRUE(list.full());
+    EXPECT_THROW(list.push_back("c"), std::length_error);
+
+    list.pop_back();
+    list.push_back("c"); // 复用刚释放的槽位
+    EXPECT_EQ(list.front(), "b");
+    EXPECT_EQ(list.back(), "c");
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+}
+
+// 测试异或链表两端的增删与双向遍历
+TEST(XorLinkedListTest, BothEndsAndTraversal) {
+    XorLinkedList<int> list{2, 3};
+    list.push_front(1);
+    list.push_back(5);
+    auto it = list.begin();
+    ++it;
+    ++it;
+    ++it; // 指向 5
+    it = list.insert(it, 4);
+    EXPECT_EQ(*it, 4);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), (std::vector<int>{1, 2, 3, 4, 5}));
+
+    std::vector<int> backwards;
+    for (auto rit = list.end(); rit != list.begin();) {
+        --rit;
+        backwards.push_back(*rit);
+    }
+    EXPECT_EQ(backwards, (std::vector<int>{5, 4, 3, 2, 1}));
+
+    list.reverse();
+    EXPECT_EQ(list.front(), 5);
+    EXPECT_EQ(list.back(), 1);
+    list.pop_front();
+    list.pop_back();
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), (std::vector<int>{4, 3, 2}));
+    EXPECT_EQ(sizeof(XorLinkedList<uint64_t>::Node) + sizeof(void*), sizeof(DoublyLinkedList<uint64_t>::Node));
+}
+
+// 测试按迭代器删除以及拷贝、移动
+TEST(XorLinkedListTest, EraseCopyAndMove) {
+    XorLinkedList<std::string> list{"a", "b", "c", "d"};
+    for (auto it = list.begin(); it != list.end();) {
+        if (*it == "b" || *it == "d") {
+            it = list.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    XorLinkedList<std::string> copy = list;
+    XorLinkedList<std::string> moved = std::move(list);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(std::vector<std::string>(copy.begin(), copy.end()), (std::vector<std::string>{"a", "c"}));
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_EQ(moved.back(), "c");
+
+    moved.clear();
+    EXPECT_THROW(moved.pop_back(), std::out_of_range);
+    moved.push_back("z");
+    EXPECT_EQ(moved.front(), "z");
+}
+
+// 测试压缩链接链表与 DoublyLinkedList 接口一致，扩容后迭代器仍然有效
+TEST(CompactDoublyLinkedListTest, MatchesListApi) {
+    CompactDoublyLinkedList<std::string> list{"b", "c"};
+    list.push_front("a");
+    auto it = list.begin();
+    ++it; // 指向 b
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(std::to_string(i)); // 多次扩容
+    }
+    EXPECT_EQ(*it, "b");
+    list.insert(it, list.front()); // 插入值引用自身元素
+    EXPECT_EQ(list.size(), 104);
+    EXPECT_EQ(list.remove("a"), 2);
+    EXPECT_EQ(list.front(), "b");
+
+    auto first = list.begin();
+    ++first;
+    ++first;
+    list.erase(first, list.end()); // 只剩 b c
+    EXPECT_EQ(std::vector<std::string>(list.begin(), list.end()), (std::vector<std::string>{"b", "c"}));
+
+    CompactDoublyLinkedList<std::string> copy = list;
+    CompactDoublyLinkedList<std::string> moved = std::move(list);
+    moved.pop_back();
+    EXPECT_EQ(copy.back(), "c");
+    EXPECT_EQ(moved.back(), "b");
+    EXPECT_TRUE(list.empty());
+    EXPECT_THROW(list.pop_front(), std::out_of_range);
+}
+
+// 测试去重以及释放的槽位被复用
+TEST(CompactDoublyLinkedListTest, UniqueAndSlotReuse) {
+    CompactDoublyLinkedList<int> list{1, 1, 2, 2, 2, 3, 1};
+    EXPECT_EQ(list.unique(), 3);
+    EXPECT_EQ(std::vector<int>(list.begin(), list.end()), (std::vector<int>{1, 2, 3, 1}));
+    EXPECT_EQ(sizeof(CompactDoublyLinkedList<int>::Node), 12);
+
+    const uint64_t capacity = list.capacity();
+    for (int round = 0; round < 10; ++round) {
+        list.push_back(round);
+        list.pop_front();
+    }
+    EXPECT_EQ(list.capacity(), capacity);
+    EXPECT_EQ(list.size(), 4);
+    EXPECT_EQ(list.back(), 9);
+}
+
+// 测试超出驻留上限的中间段被写入磁盘，并能按顺序流式读回
+TEST(SpillableListTest, SpillsMiddleSegmentsAndStreamsBack) {
+    SpillableList<uint64_t> list(SpillOptions{.segment_elements = 4, .memory_segments = 3, .read_ahead = 2});
+    for (uint64_t i = 0; i < 100; ++i) {
+        list.push_back(i);
+    }
+    EXPECT_EQ(list.size(), 100);
+    EXPECT_EQ(list.resident_segments(), 3);
+    EXPECT_EQ(list.spilled_segments(), 22);
+    EXPECT_EQ(list.bytes_on_disk(), 22 * 4 * sizeof(uint64_t));
+
+    uint64_t expected = 0;
+    for (uint64_t value : list) { // 遍历不改变驻留状态
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, 100);
+    EXPECT_EQ(list.spilled_segments(), 22);
+
+    for (uint64_t i = 0; i < 60; ++i) {
+        EXPECT_EQ(list.front(), i);
+        list.pop_front();
+    }
+    EXPECT_EQ(list.back(), 99);
+    EXPECT_LE(list.resident_segments(), 3);
+}
+
+// 测试两端混合使用以及块的复用
+TEST(SpillableListTest, BothEndsAndChunkReuse) {
+    SpillableList<int> list(SpillOptions{.segment_elements = 2, .memory_segments = 2});
+    std::deque<int> expected;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            list.push_front(-i);
+            expected.push_front(-i);
+            list.push_back(i);
+            expected.push_back(i);
+        }
+        for (int i = 0; i < 15; ++i) {
+            EXPECT_EQ(list.back(), expected.back());
+            list.pop_back();
+            expected.pop_back();
+            EXPECT_EQ(list.front(), expected.front());
+            list.pop_front();
+            expected.pop_front();
+        }
+    }
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end()));
+    EXPECT_LE(list.spilled_segments() * 2, list.size());
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.bytes_on_disk(), 0);
+    EXPECT_THROW(list.pop_back(), std::out_of_range);
+}
+
+// 测试重新打开目录时由快照和日志恢复出相同的内容
+TEST(DurableListTest, RecoversFromCheckpointAndLog) {
+    const auto directory = std::filesystem::temp_directory_path() / "mystl_durable_recover";
+    std::filesystem::remove_all(directory);
+    {
+        DurableList<int> list(directory, DurabilityOptions{.sync_every = 8, .checkpoint_every = 50});
+        for (int i = 0; i < 40; ++i) {
+            list.push_back(i);
+        }
+        for (int i = 0; i < 10; ++i) {
+            list.pop_front();
+        }
+        EXPECT_EQ(list.generation(), 1); // 第 50 条记录触发了检查点
+        EXPECT_EQ(list.log_records(), 0);
+        list.insert(0, -1);
+        list.insert(2, -2);
+        list.insert(list.size(), -3);
+        EXPECT_THROW(list.insert(list.size() + 1, 0), std::out_of_range);
+        EXPECT_EQ(list.pending_records(), 3);
+    }
+    {
+        DurableList<int> list(directory);
+        std::vector<int> values;
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            values.push_back(*it);
+        }
+        std::vector<int> expected{-1, 10, -2};
+        for (int i = 11; i < 40; ++i) {
+            expected.push_back(i);
+        }
+        expected.push_back(-3);
+        EXPECT_EQ(values, expected);
+        EXPECT_EQ(list.log_records(), 3);
+
+        list.clear();
+        list.push_back(7);
+        list.checkpoint();
+        EXPECT_FALSE(std::filesystem::exists(directory / "wal.1"));
+    }
+    {
+        DurableList<int> list(directory);
+        EXPECT_EQ(list.size(), 1);
+        EXPECT_EQ(list.front(), 7);
+        EXPECT_EQ(list.generation(), 2);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+// 测试崩溃时只丢失未提交的批次，写了一半的记录被截掉
+TEST(DurableListTest, CrashLosesOnlyUncommittedBatch) {
+    const auto directory = std::filesystem::temp_directory_path() / "mystl_durable_crash";
+    const auto crashed = std::filesystem::temp_directory_path() / "mystl_durable_crash_copy";
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove_all(crashed);
+    {
+        DurableList<uint64_t> list(directory, DurabilityOptions{.sync_every = 4});
+        for (uint64_t i = 0; i < 6; ++i) {
+            list.push_back(i);
+        }
+        EXPECT_EQ(list.sync_count(), 1);
+        EXPECT_EQ(list.pending_records(), 2);
+
+        // 在析构提交之前复制目录，相当于此刻掉电
+        std::filesystem::copy(directory, crashed);
+    }
+    {
+        // 模拟写到一半的记录
+        std::FILE* log = std::fopen((crashed / "wal.0").c_str(), "ab");
+        std::fputs("torn", log);
+        std::fclose(log);
+    }
+    {
+        DurableList<uint64_t> list(crashed);
+        EXPECT_EQ(list.size(), 4);
+        EXPECT_EQ(list.back(), 3);
+        list.push_back(100); // 截断后继续追加的记录必须能正常重放
+    }
+    {
+        DurableList<uint64_t> list(crashed);
+        EXPECT_EQ(list.size(), 5);
+        EXPECT_EQ(list.back(), 100);
+    }
+    {
+        DurableList<uint64_t> list(directory);
+        EXPECT_EQ(list.size(), 6);
+    }
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove_all(crashed);
+}
+
+// 测试提交只写进去一部分就失败时，重试先截掉残留的部分，记录不会重复也不会夹着残片
+TEST(DurableListTest, RetriedSyncDoesNotDuplicateRecords) {
+    const auto directory = std::filesystem::temp_directory_path() / "mystl_durable_retry";
+    std::filesystem::remove_all(directory);
+    {
+        DurableList<uint64_t> list(directory, DurabilityOptions{.sync_every = 100});
+        for (uint64_t i = 0; i < 4; ++i) {
+            list.push_back(i);
+        }
+        list.sync();
+        for (uint64_t i = 4; i < 8; ++i) {
+            list.push_back(i);
+        }
+
+        // 限制文件大小，让这次提交只写进去半批
+        const auto committed = std::filesystem::file_size(directory / "wal.0");
+        rlimit original{};
+        ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &original), 0);
+        const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit limited = original;
+        limited.rlim_cur = committed + 30;
+        ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limited), 0);
+        EXPECT_THROW(list.sync(), std::system_error);
+        ::setrlimit(RLIMIT_FSIZE, &original);
+        std::signal(SIGXFSZ, previous_handler);
+        EXPECT_EQ(std::filesystem::file_size(directory / "wal.0"), committed + 30);
+
+        list.sync();
+        EXPECT_EQ(list.pending_records(), 0);
+    }
+    {
+        DurableList<uint64_t> list(directory);
+        std::vector<uint64_t> values(list.begin(), list.end());
+        EXPECT_EQ(values, (std::vector<uint64_t>{0, 1, 2, 3, 4, 5, 6, 7}));
+    }
+    std::filesystem::remove_all(directory);
+}
+
+// 测试协程在空队列上挂起，push 按挂起顺序把元素直接交给等待者
+TEST(AsyncQueueTest, SuspendsAndResumesInOrder) {
+    CoroutineRunQueue scheduler;
+    AsyncQueue<std::string> queue(std::ref(scheduler));
+    std::vector<std::string> received;
+
+    auto consumer = [](AsyncQueue<std::string>& queue, std::vector<std::string>& received, int count) -> DetachedTask {
+        for (int i = 0; i < count; ++i) {
+            received.push_back(co_await queue.pop());
+        }
+    };
+
+    queue.push_back("ready");
+    consumer(queue, received, 2); // 第一个元素不需要挂起
+    consumer(queue, received, 2);
+    EXPECT_EQ(received, std::vector<std::string>{"ready"});
+    EXPECT_EQ(queue.waiting(), 2);
+
+    queue.push_back("a");
+    queue.push_back("b");
+    EXPECT_EQ(queue.waiting(), 0);
+    EXPECT_TRUE(queue.empty()); // 元素已交给等待者
+    EXPECT_EQ(received.size(), 1); // 调度器运行之前不会恢复
+    EXPECT_EQ(scheduler.run(), 2);
+    EXPECT_EQ(received, (std::vector<std::string>{"ready", "a", "b"}));
+
+    queue.push_back("c");
+    queue.push_back("d");
+    scheduler.run();
+    EXPECT_EQ(received.back(), "c");
+    EXPECT_EQ(queue.try_pop(), "d");
+    EXPECT_FALSE(queue.try_pop().has_value());
+}
+
+// 测试线程安全模式下从另一个线程 push 唤醒挂起的协程
+TEST(AsyncQueueTest, ThreadSafePushFromAnotherThread) {
+    AsyncQueue<int, true> requests;
+    AsyncQueue<int, true> replies;
+    std::atomic<long long> sum = 0;
+
+    // 没有调度钩子时协程在 push 的线程上恢复
+    auto echo = [](AsyncQueue<int, true>& requests, AsyncQueue<int, true>& replies, std::atomic<long long>& sum) -> DetachedTask {
+        while (true) {
+            const int val = co_await requests.pop();
+            if (val < 0) {
+                break;
+            }
+            sum += val;
+            replies.push_back(val * 2);
+        }
+    };
+    echo(requests, replies, sum);
+    EXPECT_EQ(requests.waiting(), 1);
+
+    std::thread producer([&requests] {
+        for (int i = 1; i <= 1000; ++i) {
+            requests.push_back(i);
+        }
+        requests.push_back(-1);
+    });
+    producer.join();
+
+    EXPECT_EQ(sum.load(), 500500);
+    EXPECT_EQ(replies.size(), 1000);
+    EXPECT_EQ(replies.try_pop(), 2);
+    EXPECT_EQ(requests.waiting(), 0);
+}
+
+// 测试容量上限、超时以及阻塞的生产者被 pop 唤醒
+TEST(BlockingQueueTest, CapacityTimeoutsAndWakeups) {
+    using namespace std::chrono_literals;
+    BlockingQueue<int> queue(2);
+    EXPECT_THROW(BlockingQueue<int>(0), std::invalid_argument);
+
+    EXPECT_TRUE(queue.try_push(1));
+    EXPECT_TRUE(queue.try_push(2));
+    EXPECT_FALSE(queue.try_push(3));
+    EXPECT_TRUE(queue.full());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.push_for(3, 20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+
+    // 生产者挂起在满队列上，消费者取走一个元素后它才能完成
+    std::atomic<bool> pushed = false;
+    std::thread producer([&] {
+        queue.push(3);
+        pushed = true;
+    });
+    std::this_thread::sleep_for(10ms);
+    EXPECT_FALSE(pushed.load());
+    EXPECT_EQ(queue.pop(), 1);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+
+    std::vector<int> out(8);
+    EXPECT_EQ(queue.pop_batch(std::span<int>(out), 1, 0ms), 1);
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(queue.pop_batch(std::span<int>(out), out.size(), 0ms), 1);
+    EXPECT_EQ(out[0], 3);
+
+    start = std::chrono::steady_clock::now();
+    EXPECT_EQ(queue.pop_batch(std::span<int>(out), out.size(), 20ms), 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    EXPECT_FALSE(queue.try_pop().has_value());
+
+    // 消费者挂起在空队列上，push 唤醒它
+    std::thread consumer([&] {
+        EXPECT_EQ(queue.pop_batch(std::span<int>(out), out.size(), 10s), 1);
+    });
+    std::this_thread::sleep_for(10ms);
+    queue.push(4);
+    consumer.join();
+    EXPECT_EQ(out[0], 4);
+    EXPECT_TRUE(queue.empty());
+}
+
+// 测试多生产者多消费者在小容量下不丢失、不重复
+TEST(BlockingQueueTest, ManyProducersAndConsumers) {
+    using namespace std::chrono_literals;
+    BlockingQueue<uint64_t> queue(16);
+    constexpr uint64_t per_producer = 5000;
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<uint64_t> count = 0;
+
+    std::vector<std::thread> threads;
+    for (uint64_t p = 0; p < 2; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (uint64_t i = 1; i <= per_producer; ++i) {
+                queue.push(p * per_producer + i);
+            }
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&] {
+            std::vector<uint64_t> out(7);
+            while (count.load() < 2 * per_producer) {
+                const uint64_t popped = queue.pop_batch(std::span<uint64_t>(out), out.size(), 5ms);
+                for (uint64_t i = 0; i < popped; ++i) {
+                    sum += out[i];
+                }
+                count += popped;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(count.load(), 2 * per_producer);
+    EXPECT_EQ(sum.load(), 2 * per_producer * (2 * per_producer + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+// 测试按级优先、同级先进先出，以及按句柄降级、提升和删除
+TEST(MultiLevelQueueTest, PriorityOrderAndMoves) {
+    MultiLevelQueue<std::string, 8> queue;
+    EXPECT_EQ(queue.top_level(), 8);
+    EXPECT_THROW(queue.pop(), std::out_of_range);
+    EXPECT_THROW(queue.push("x", 8), std::out_of_range);
+
+    auto editor = queue.push("editor", 2);
+    auto compiler = queue.push("compiler", 5);
+    queue.push("shell", 2);
+    auto daemon = queue.push("daemon", 7);
+    EXPECT_EQ(queue.size(), 4);
+    EXPECT_EQ(queue.top_level(), 2);
+    EXPECT_EQ(queue.top(), "editor");
+
+    // 用完时间片的任务降一级，等待 I/O 的任务提升到最高级
+    queue.move(editor, 3);
+    EXPECT_EQ(editor.level(), 3);
+    EXPECT_EQ(queue.value(editor), "editor");
+    queue.move(daemon, 0);
+    EXPECT_EQ(queue.top_level(), 0);
+    EXPECT_EQ(queue.size(0), 1);
+    EXPECT_EQ(queue.size(7), 0);
+
+    queue.erase(compiler);
+    EXPECT_EQ(queue.size(), 3);
+
+    EXPECT_EQ(queue.pop(), "daemon");
+    EXPECT_EQ(queue.pop(), "shell");
+    EXPECT_EQ(queue.top_level(), 3);
+    queue.move(editor, 3); // 同级移动相当于重新排到队尾
+    queue.push("late", 3);
+    EXPECT_EQ(queue.pop(), "editor");
+    EXPECT_EQ(queue.pop(), "late");
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.top_level(), 8);
+
+    queue.push("a", 1);
+    queue.push("b", 6);
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.top_level(), 8);
+}
+
+// 随机操作与逐级 std::deque 的参考实现对比
+TEST(MultiLevelQueueTest, MatchesReferenceModel) {
+    MultiLevelQueue<int> queue;
+    std::vector<std::deque<int>> reference(64);
+    std::vector<std::pair<int, MultiLevelQueue<int>::handle_type>> live;
+    std::mt19937 rng(47);
+
+    auto reference_remove = [&reference](uint32_t level, int val) {
+        auto& list = reference[level];
+        list.erase(std::find(list.begin(), list.end(), val));
+    };
+
+    for (int step = 0; step < 20000; ++step) {
+        const uint32_t op = rng() % 10;
+        if (op < 4 || live.empty()) {
+            const uint32_t level = rng() % 64;
+            live.emplace_back(step, queue.push(step, level));
+            reference[level].push_back(step);
+        } else if (op < 7) {
+            auto& [val, handle] = live[rng() % live.size()];
+            const uint32_t level = rng() % 64;
+            reference_remove(handle.level(), val);
+            reference[level].push_back(val);
+            queue.move(handle, level);
+        } else if (op < 8) {
+            const uint64_t index = rng() % live.size();
+            reference_remove(live[index].second.level(), live[index].first);
+            queue.erase(live[index].second);
+            live[index] = live.back();
+            live.pop_back();
+        } else {
+            auto level = std::find_if(reference.begin(), reference.end(), [](const auto& list) { return !list.empty(); });
+            ASSERT_EQ(queue.top_level(), level - reference.begin());
+            const int val = queue.pop();
+            EXPECT_EQ(val, level->front());
+            level->pop_front();
+            live.erase(std::find_if(live.begin(), live.end(), [val](const auto& entry) { return entry.first == val; }));
+        }
+        ASSERT_EQ(queue.size(), live.size());
+    }
+
+    for (uint32_t level = 0; level < 64; ++level) {
+        EXPECT_EQ(queue.size(level), reference[level].size());
+    }
+    while (!queue.empty()) {
+        auto level = std::find_if(reference.begin(), reference.end(), [](const auto& list) { return !list.empty(); });
+        EXPECT_EQ(queue.pop(), level->front());
+        level->pop_front();
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv); // 初始化 Google Test
     return RUN_ALL_TESTS(); // 运行所有测试